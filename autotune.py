@@ -0,0 +1,210 @@
+#!/usr/bin/env python3
+"""Ajuste automático do Odd-Even Transposition Sort para a máquina atual.
+
+'calibrar' mede, para cada tamanho pedido, as configurações disponíveis: versão serial (simples e
+ladrilhada), OpenMP (threads x política, com larguras de ladrilho/pedaço) e MPI (processos x modo
+de troca, com tamanhos de pedaço), todas sobre a mesma entrada com semente fixa. A melhor
+configuração de cada motor em cada tamanho é gravada em um perfil de texto por host
+(odd_even_perfil_<host>.txt, ou o caminho de --profile / ODD_EVEN_PROFILE), lido depois sem
+nenhum custo de calibração:
+
+    odd_even_openmp <tamanho> auto        usa a melhor configuração OpenMP do tamanho mais próximo
+    python3 autotune.py executar <tamanho>  executa o motor mais rápido (inclusive o número de
+                                            processos MPI) calibrado para o tamanho mais próximo
+
+Exemplo:
+
+    python3 autotune.py calibrar --sizes 1000 10000 50000 --threads 1 2 4 --ranks 1 2 4
+"""
+
+import argparse
+import math
+import os
+import shlex
+import socket
+import statistics
+import subprocess
+import sys
+import time
+
+from benchmark import run_once
+
+OPENMP_POLICIES = ["static", "dynamic", "guided", "bloco", "ladrilhado", "fluxo"]
+MPI_MODES = ["bloco", "elemento", "sobreposto", "compartilhado"]
+
+
+def default_profile_path():
+    """Mesmo nome padrão usado por odd_even_tune.h."""
+    return os.environ.get("ODD_EVEN_PROFILE") or "odd_even_perfil_%s.txt" % socket.gethostname()
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--profile", default=default_profile_path(), help="arquivo do perfil")
+    parser.add_argument("--bindir", default=".", help="diretório dos executáveis")
+    parser.add_argument("--mpirun", default="mpirun", help="comando de lançamento MPI")
+    parser.add_argument("--mpirun-args", default="", help="argumentos extras para o mpirun")
+    commands = parser.add_subparsers(dest="command")
+
+    calibrate = commands.add_parser("calibrar", help="mede as configurações e grava o perfil")
+    calibrate.add_argument("--sizes", type=int, nargs="+", default=[1000, 10000, 50000])
+    calibrate.add_argument("--engines", nargs="+", default=["serial", "openmp", "mpi"],
+                           choices=["serial", "openmp", "mpi"])
+    calibrate.add_argument("--threads", type=int, nargs="+", default=None,
+                           help="padrão: 1, 2, 4, ... até o número de CPUs")
+    calibrate.add_argument("--policies", nargs="+", default=OPENMP_POLICIES, choices=OPENMP_POLICIES)
+    calibrate.add_argument("--tile-widths", type=int, nargs="+", default=[1024, 4096, 16384],
+                           help="larguras de ladrilho (pares) das versões ladrilhadas")
+    calibrate.add_argument("--phase-depths", type=int, nargs="+", default=[256, 1024],
+                           help="fases por ladrilho das versões ladrilhadas")
+    calibrate.add_argument("--flow-widths", type=int, nargs="+", default=[256, 1024, 4096],
+                           help="pares por pedaço da política fluxo")
+    calibrate.add_argument("--ranks", type=int, nargs="+", default=[1, 2, 4])
+    calibrate.add_argument("--mpi-modes", nargs="+", default=["bloco", "sobreposto", "compartilhado"],
+                           choices=MPI_MODES)
+    calibrate.add_argument("--chunk-elements", type=int, nargs="+", default=[16384, 65536],
+                           help="elementos por pedaço do modo MPI sobreposto")
+    calibrate.add_argument("--reps", type=int, default=3, help="repetições medidas (vale a mediana)")
+    calibrate.add_argument("--warmup", type=int, default=1, help="execuções de aquecimento descartadas")
+    calibrate.add_argument("--seed", type=int, default=42)
+    calibrate.add_argument("--dist", default="uniforme")
+    calibrate.add_argument("--timeout", type=float, default=120.0, help="limite por execução (s)")
+
+    execute = commands.add_parser("executar", help="executa a melhor configuração calibrada")
+    execute.add_argument("size", type=int)
+    execute.add_argument("--engines", nargs="+", default=["serial", "openmp", "mpi"],
+                         choices=["serial", "openmp", "mpi"], help="motores admitidos na escolha")
+    args = parser.parse_args()
+    if args.command is None:
+        parser.error("indique 'calibrar' ou 'executar'")
+    return args
+
+
+def default_thread_counts():
+    cpus = os.cpu_count() or 1
+    counts, threads = [], 1
+    while threads < cpus:
+        counts.append(threads)
+        threads *= 2
+    return counts + [cpus]
+
+
+def candidates(args):
+    """Gera (motor, trabalhadores, política, largura, profundidade); 0 = padrão do binário."""
+    if "serial" in args.engines:
+        yield "serial", 1, "simples", 0, 0
+        for width in args.tile_widths:
+            for depth in args.phase_depths:
+                yield "serial", 1, "ladrilhado", width, depth
+    if "openmp" in args.engines:
+        for threads in args.threads or default_thread_counts():
+            for policy in args.policies:
+                if policy == "ladrilhado":
+                    for width in args.tile_widths:
+                        for depth in args.phase_depths:
+                            yield "openmp", threads, policy, width, depth
+                elif policy == "fluxo":
+                    for width in args.flow_widths:
+                        yield "openmp", threads, policy, width, 0
+                else:
+                    yield "openmp", threads, policy, 0, 0
+    if "mpi" in args.engines:
+        for ranks in args.ranks:
+            for mode in args.mpi_modes:
+                if mode == "sobreposto":
+                    for chunk in args.chunk_elements:
+                        yield "mpi", ranks, mode, chunk, 4
+                else:
+                    yield "mpi", ranks, mode, 0, 0
+
+
+def command_for(args, size, engine, workers, policy, width, depth):
+    """Linha de comando de uma configuração (a mesma usada na calibração e em 'executar')."""
+    extra = ([str(width)] if width > 0 else []) + ([str(depth)] if width > 0 and depth > 0 else [])
+    if engine == "serial":
+        return [os.path.join(args.bindir, "odd_even_serial"), str(size), policy] + extra
+    if engine == "openmp":
+        return [os.path.join(args.bindir, "odd_even_openmp"), str(size), str(workers), policy] + extra
+    return (shlex.split(args.mpirun) + ["-np", str(workers)] + shlex.split(args.mpirun_args) +
+            [os.path.join(args.bindir, "odd_even_mpi"), str(size), policy] + extra)
+
+
+def calibrate(args):
+    if args.reps <= 0 or args.warmup < 0:
+        sys.exit("Erro: --reps deve ser positivo e --warmup não negativo.")
+    env = dict(os.environ, ODD_EVEN_DIST=args.dist, ODD_EVEN_SEED=str(args.seed))
+    best = {}  # (tamanho, motor) -> (mediana, trabalhadores, política, largura, profundidade)
+    print("%8s %-7s %13s %-13s %8s %8s %11s" %
+          ("tamanho", "motor", "trabalhadores", "política", "largura", "profund.", "mediana(s)"))
+    for size in args.sizes:
+        for engine, workers, policy, width, depth in candidates(args):
+            command = command_for(args, size, engine, workers, policy, width, depth)
+            try:
+                for _ in range(args.warmup):
+                    run_once(command, env, args.timeout)
+                samples = []
+                for _ in range(args.reps):
+                    elapsed, is_sorted = run_once(command, env, args.timeout)
+                    if not is_sorted:
+                        raise RuntimeError("saída não ordenada")
+                    samples.append(elapsed)
+            except RuntimeError as error:
+                print("%8d %-7s %13d %-13s %8d %8d erro: %s" % (size, engine, workers, policy, width, depth, error))
+                continue
+            median = statistics.median(samples)
+            print("%8d %-7s %13d %-13s %8d %8d %11.6f" % (size, engine, workers, policy, width, depth, median))
+            key = (size, engine)
+            if key not in best or median < best[key][0]:
+                best[key] = (median, workers, policy, width, depth)
+
+    with open(args.profile, "w") as profile:
+        profile.write("# Perfil do Odd-Even para o host %s, gerado por autotune.py em %s\n" %
+                      (socket.gethostname(), time.strftime("%Y-%m-%dT%H:%M:%S")))
+        profile.write("# Distribuição %s, semente %d, mediana de %d repetições\n" % (args.dist, args.seed, args.reps))
+        profile.write("# tamanho motor trabalhadores política largura profundidade mediana_s\n")
+        for (size, engine), (median, workers, policy, width, depth) in sorted(best.items()):
+            profile.write("%d %s %d %s %d %d %.6f\n" % (size, engine, workers, policy, width, depth, median))
+    print("Perfil gravado em %s" % args.profile)
+
+
+def load_profile(path):
+    entries = []
+    with open(path) as profile:
+        for line in profile:
+            fields = line.split()
+            if not fields or fields[0].startswith("#") or len(fields) != 7:
+                continue
+            entries.append({"size": int(fields[0]), "engine": fields[1], "workers": int(fields[2]),
+                            "policy": fields[3], "width": int(fields[4]), "depth": int(fields[5]),
+                            "seconds": float(fields[6])})
+    return entries
+
+
+def execute(args):
+    try:
+        entries = [e for e in load_profile(args.profile) if e["engine"] in args.engines]
+    except OSError:
+        sys.exit("Erro: perfil '%s' não encontrado; rode 'python3 autotune.py calibrar' antes." % args.profile)
+    if not entries:
+        sys.exit("Erro: o perfil '%s' não tem configurações dos motores pedidos." % args.profile)
+    # Tamanho calibrado mais próximo em escala logarítmica; nele, o motor mais rápido
+    nearest = min(entries, key=lambda e: abs(math.log(e["size"] / args.size)))["size"]
+    chosen = min((e for e in entries if e["size"] == nearest), key=lambda e: e["seconds"])
+    command = command_for(args, args.size, chosen["engine"], chosen["workers"], chosen["policy"],
+                          chosen["width"], chosen["depth"])
+    print("Configuração automática (calibrada para %d elementos): %s" % (nearest, " ".join(command)),
+          file=sys.stderr)
+    sys.stdout.flush()
+    return subprocess.call(command)
+
+
+def main():
+    args = parse_args()
+    if args.command == "calibrar":
+        calibrate(args)
+    else:
+        sys.exit(execute(args))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+"""Benchmark reprodutível das versões serial, OpenMP e MPI do Odd-Even Transposition Sort.
+
+Para cada distribuição e tamanho, todas as configurações ordenam exatamente a mesma entrada
+(mesma semente, via ODD_EVEN_SEED/ODD_EVEN_DIST). Cada configuração roda algumas vezes para
+aquecimento (descartadas) e depois N repetições; o relatório traz mediana, p95, mínimo e média,
+além de speedup e eficiência em relação à mediana da versão serial.
+
+Os resultados são gravados em CSV e JSON para acompanhar regressões e curvas de escalabilidade
+entre builds. Exemplo:
+
+    python3 benchmark.py --sizes 1000 10000 --threads 1 2 4 --ranks 1 2 4 --reps 5
+"""
+
+import argparse
+import csv
+import json
+import math
+import os
+import platform
+import re
+import shlex
+import statistics
+import subprocess
+import sys
+import time
+
+DISTRIBUTIONS = ["uniforme", "ordenado", "reverso", "quase_ordenado", "poucos_valores", "completo"]
+
+# Linha de tempo impressa por cada binário e indicação de ordenação correta
+TIME_PATTERN = re.compile(r"Tempo de [Ee]xecução[^:]*:\s*([0-9.]+) segundos")
+SORTED_PATTERN = re.compile(r"Status de ordenação: Ordenado|O array final está ordenado: Sim")
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--sizes", type=int, nargs="+", default=[1000, 5000, 10000, 50000, 100000])
+    parser.add_argument("--dists", nargs="+", default=["uniforme"], choices=DISTRIBUTIONS)
+    parser.add_argument("--threads", type=int, nargs="+", default=[1, 2, 4, 8])
+    parser.add_argument("--schedules", nargs="+", default=["static", "dynamic", "guided"],
+                        help="políticas do odd_even_openmp (static, dynamic, guided, bloco, ladrilhado, fluxo)")
+    parser.add_argument("--placements", nargs="+", default=["primeiro_toque"],
+                        choices=["primeiro_toque", "ingenuo"],
+                        help="posicionamento de memória do odd_even_openmp (ODD_EVEN_PLACEMENT); passe os dois "
+                             "para comparar o primeiro toque paralelo com a alocação serial")
+    parser.add_argument("--ranks", type=int, nargs="+", default=[1, 2, 4])
+    parser.add_argument("--engines", nargs="+", default=["serial", "openmp", "mpi"],
+                        choices=["serial", "openmp", "mpi", "hibrido"],
+                        help="'hibrido' combina cada --ranks com cada --threads (OMP_NUM_THREADS; "
+                             "em vários nós com Open MPI, passe '-x OMP_NUM_THREADS' em --mpirun-args)")
+    parser.add_argument("--reps", type=int, default=5, help="repetições medidas")
+    parser.add_argument("--warmup", type=int, default=1, help="execuções de aquecimento descartadas")
+    parser.add_argument("--seed", type=int, default=42)
+    parser.add_argument("--mpirun", default="mpirun", help="comando de lançamento MPI")
+    parser.add_argument("--mpirun-args", default="", help="argumentos extras para o mpirun")
+    parser.add_argument("--bindir", default=".", help="diretório dos executáveis")
+    parser.add_argument("--timeout", type=float, default=600.0, help="limite por execução (s)")
+    parser.add_argument("--csv", default="benchmark_results.csv")
+    parser.add_argument("--json", default="benchmark_results.json")
+    return parser.parse_args()
+
+
+def percentile(samples, fraction):
+    """Percentil pelo método do posto mais próximo."""
+    ordered = sorted(samples)
+    rank = max(1, math.ceil(fraction * len(ordered)))
+    return ordered[min(rank, len(ordered)) - 1]
+
+
+def run_once(command, env, timeout):
+    """Executa o binário uma vez; devolve (tempo, ordenado) ou levanta RuntimeError."""
+    try:
+        result = subprocess.run(command, env=env, stdout=subprocess.PIPE, stderr=subprocess.DEVNULL,
+                                universal_newlines=True, timeout=timeout)
+    except subprocess.TimeoutExpired:
+        raise RuntimeError("tempo limite excedido")
+    if result.returncode != 0:
+        raise RuntimeError("código de saída %d" % result.returncode)
+    match = TIME_PATTERN.search(result.stdout)
+    if match is None:
+        raise RuntimeError("linha de tempo não encontrada")
+    return float(match.group(1)), bool(SORTED_PATTERN.search(result.stdout))
+
+
+def measure(command, env, args):
+    for _ in range(args.warmup):
+        run_once(command, env, args.timeout)
+    samples, all_sorted = [], True
+    for _ in range(args.reps):
+        elapsed, is_sorted = run_once(command, env, args.timeout)
+        samples.append(elapsed)
+        all_sorted = all_sorted and is_sorted
+    return samples, all_sorted
+
+
+def configurations(args, size):
+    """Gera (motor, descrição, trabalhadores, comando, variáveis extras) para um tamanho."""
+    binary = lambda name: os.path.join(args.bindir, name)
+    mpi_launch = lambda ranks: shlex.split(args.mpirun) + ["-np", str(ranks)] + shlex.split(args.mpirun_args)
+    if "serial" in args.engines:
+        yield "serial", "serial", 1, [binary("odd_even_serial"), str(size)], {}
+    if "openmp" in args.engines:
+        for threads in args.threads:
+            for schedule in args.schedules:
+                for placement in args.placements:
+                    label = "%d threads %s" % (threads, schedule)
+                    if len(args.placements) > 1:
+                        label += " " + placement
+                    yield ("openmp", label, threads,
+                           [binary("odd_even_openmp"), str(size), str(threads), schedule],
+                           {"ODD_EVEN_PLACEMENT": placement})
+    if "mpi" in args.engines:
+        for ranks in args.ranks:
+            yield "mpi", "%d ranks" % ranks, ranks, mpi_launch(ranks) + [binary("odd_even_mpi"), str(size)], {}
+    if "hibrido" in args.engines:
+        for ranks in args.ranks:
+            for threads in args.threads:
+                yield ("hibrido", "%d ranks x %d threads" % (ranks, threads), ranks * threads,
+                       mpi_launch(ranks) + [binary("odd_even_hybrid"), str(size)],
+                       {"OMP_NUM_THREADS": str(threads)})
+
+
+def main():
+    args = parse_args()
+    if args.reps <= 0 or args.warmup < 0:
+        sys.exit("Erro: --reps deve ser positivo e --warmup não negativo.")
+
+    results = []
+    print("%-14s %8s %-7s %-32s %11s %11s %8s %8s %s" %
+          ("distribuição", "tamanho", "motor", "configuração", "mediana(s)", "p95(s)",
+           "speedup", "efic.", "ordenado"))
+    for dist in args.dists:
+        for size in args.sizes:
+            env = dict(os.environ, ODD_EVEN_DIST=dist, ODD_EVEN_SEED=str(args.seed))
+            serial_median = None
+            for engine, config, workers, command, extra_env in configurations(args, size):
+                record = {"engine": engine, "config": config, "workers": workers,
+                          "distribution": dist, "size": size, "seed": args.seed,
+                          "warmup": args.warmup, "reps": args.reps}
+                try:
+                    samples, all_sorted = measure(command, dict(env, **extra_env), args)
+                except RuntimeError as error:
+                    record["error"] = str(error)
+                    results.append(record)
+                    print("%-14s %8d %-7s %-32s erro: %s" % (dist, size, engine, config, error))
+                    continue
+                median = statistics.median(samples)
+                if engine == "serial":
+                    serial_median = median
+                speedup = serial_median / median if serial_median and median > 0 else None
+                record.update({
+                    "median_s": median,
+                    "p95_s": percentile(samples, 0.95),
+                    "min_s": min(samples),
+                    "mean_s": statistics.mean(samples),
+                    "speedup": speedup,
+                    "efficiency": speedup / workers if speedup is not None else None,
+                    "sorted": all_sorted,
+                    "samples_s": samples,
+                })
+                results.append(record)
+                print("%-14s %8d %-7s %-32s %11.6f %11.6f %8s %8s %s" %
+                      (dist, size, engine, config, median, record["p95_s"],
+                       "%.2f" % speedup if speedup is not None else "-",
+                       "%.2f" % record["efficiency"] if speedup is not None else "-",
+                       "sim" if all_sorted else "NÃO"))
+
+    fields = ["engine", "config", "workers", "distribution", "size", "seed", "warmup", "reps",
+              "median_s", "p95_s", "min_s", "mean_s", "speedup", "efficiency", "sorted", "error"]
+    with open(args.csv, "w", newline="") as csv_file:
+        writer = csv.DictWriter(csv_file, fieldnames=fields, extrasaction="ignore")
+        writer.writeheader()
+        writer.writerows(results)
+    with open(args.json, "w") as json_file:
+        json.dump({"host": platform.node(), "timestamp": time.strftime("%Y-%m-%dT%H:%M:%S"),
+                   "seed": args.seed, "results": results}, json_file, indent=2)
+    print("Resultados gravados em %s e %s" % (args.csv, args.json))
+
+    # Falhas de execução (queda, tempo limite, código de saída) também reprovam, não só saídas desordenadas
+    if any("error" in r or not r.get("sorted", False) for r in results):
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
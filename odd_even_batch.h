@@ -0,0 +1,146 @@
+#ifndef ODD_EVEN_BATCH_H
+#define ODD_EVEN_BATCH_H
+
+// Ordenação em lote: muitos arrays pequenos e independentes em uma única chamada.
+//
+// Os arrays ficam lado a lado em um buffer contíguo 'data'; o array i ocupa as posições
+// [offsets[i], offsets[i + 1]) (portanto 'offsets' tem batch_count + 1 entradas). Cada array é
+// ordenado pelo Odd-Even Transposition Sort, em duas classes:
+//   - arrays com até BATCH_LANE_MAX_KEYS chaves são agrupados de BATCH_LANES em BATCH_LANES
+//     (arrays consecutivos) e ordenados juntos, um array por lane SIMD: o grupo é transposto para
+//     um buffer em que a linha k guarda a k-ésima chave de cada array, as posições que faltam
+//     recebem INT_MAX e a rede fixa de transposição par-ímpar com tantas fases quanto o maior
+//     array do grupo é aplicada com min/max verticais entre linhas (AVX2: 8 arrays por registro);
+//   - os demais são distribuídos entre as threads (schedule dynamic) e cada um é ordenado por uma
+//     única thread com o kernel de compare-exchange de odd_even_kernel.h.
+// A rede não depende dos dados, então o custo de uma chamada só depende dos tamanhos.
+//
+// odd_even_sort_batch pode ser chamada dentro de uma região paralela já aberta: nesse caso os
+// laços são compartilhados (orphaned) pela equipe existente e todas as threads da equipe devem
+// chamá-la. Assim, uma única equipe atende a uma sequência de lotes sem recriar threads; fora de
+// uma região paralela, a função abre a sua própria.
+
+#include <limits.h>
+#include <omp.h>
+#include "odd_even_kernel.h"
+
+// Arrays com até esta quantidade de chaves são ordenados em lanes SIMD
+#define BATCH_LANE_MAX_KEYS 32
+// Arrays por grupo de lanes (inteiros de 32 bits em um registro AVX2)
+#define BATCH_LANES 8
+
+// Assinatura comum das redes em lanes: ordena as 'rows' linhas transpostas (BATCH_LANES por linha)
+typedef void (*batch_lane_network_fn)(int lanes[][BATCH_LANES], int rows);
+
+// Versão escalar sem desvios (o compilador gera cmov)
+static inline void batch_lane_network_scalar(int lanes[][BATCH_LANES], int rows) {
+    for (int phase = 0; phase < rows; ++phase) {
+        for (int row = phase % 2; row + 1 < rows; row += 2) {
+            for (int lane = 0; lane < BATCH_LANES; ++lane) {
+                int upper = lanes[row][lane];
+                int lower = lanes[row + 1][lane];
+                lanes[row][lane] = (upper < lower) ? upper : lower;
+                lanes[row + 1][lane] = (upper < lower) ? lower : upper;
+            }
+        }
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// AVX2: cada linha é um registro; min/max entre linhas vizinhas ordena os 8 arrays ao mesmo tempo
+__attribute__((target("avx2")))
+static inline void batch_lane_network_avx2(int lanes[][BATCH_LANES], int rows) {
+    for (int phase = 0; phase < rows; ++phase) {
+        for (int row = phase % 2; row + 1 < rows; row += 2) {
+            __m256i upper = _mm256_load_si256((const __m256i *)lanes[row]);
+            __m256i lower = _mm256_load_si256((const __m256i *)lanes[row + 1]);
+            _mm256_store_si256((__m256i *)lanes[row], _mm256_min_epi32(upper, lower));
+            _mm256_store_si256((__m256i *)lanes[row + 1], _mm256_max_epi32(upper, lower));
+        }
+    }
+}
+#endif
+
+// Escolhe a rede em lanes conforme a CPU, respeitando ODD_EVEN_KERNEL=escalar
+static inline batch_lane_network_fn select_batch_lane_network(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (select_compare_exchange_kernel() == compare_exchange_pairs_avx2) {
+        return batch_lane_network_avx2;
+    }
+#endif
+    return batch_lane_network_scalar;
+}
+
+// Ordena os arrays pequenos do grupo [first_array, end_array) nas lanes; os demais são ignorados
+static inline void batch_sort_lane_group(batch_lane_network_fn network, int data[], const long offsets[],
+                                         int first_array, int end_array) {
+    int lanes[BATCH_LANE_MAX_KEYS][BATCH_LANES] __attribute__((aligned(32)));
+    int rows = 0;
+    for (int array_idx = first_array; array_idx < end_array; ++array_idx) {
+        long length = offsets[array_idx + 1] - offsets[array_idx];
+        if (length <= BATCH_LANE_MAX_KEYS && length > rows) rows = (int)length;
+    }
+    if (rows < 2) return;
+
+    // Transposição: a linha k recebe a k-ésima chave de cada array (INT_MAX completa as lanes)
+    for (int row = 0; row < rows; ++row) {
+        for (int lane = 0; lane < BATCH_LANES; ++lane) lanes[row][lane] = INT_MAX;
+    }
+    for (int array_idx = first_array; array_idx < end_array; ++array_idx) {
+        long length = offsets[array_idx + 1] - offsets[array_idx];
+        if (length > BATCH_LANE_MAX_KEYS) continue;
+        const int *keys = data + offsets[array_idx];
+        for (int row = 0; row < length; ++row) lanes[row][array_idx - first_array] = keys[row];
+    }
+
+    network(lanes, rows);
+
+    // As sentinelas INT_MAX terminam no fim de cada lane; só as primeiras 'length' linhas voltam
+    for (int array_idx = first_array; array_idx < end_array; ++array_idx) {
+        long length = offsets[array_idx + 1] - offsets[array_idx];
+        if (length > BATCH_LANE_MAX_KEYS) continue;
+        int *keys = data + offsets[array_idx];
+        for (int row = 0; row < length; ++row) keys[row] = lanes[row][array_idx - first_array];
+    }
+}
+
+// Odd-Even completo de um único array pela thread atual
+static inline void batch_sort_single_array(compare_exchange_kernel_fn kernel, int keys[], long length) {
+    for (long phase = 0; phase < length; ++phase) {
+        kernel(keys + (phase % 2), (int)((length - (phase % 2)) / 2));
+    }
+}
+
+// Corpo do lote executado por todas as threads de uma equipe (laços compartilhados)
+static inline void batch_sort_in_team(int data[], const long offsets[], int batch_count,
+                                      compare_exchange_kernel_fn kernel, batch_lane_network_fn network) {
+    int group_count = (batch_count + BATCH_LANES - 1) / BATCH_LANES;
+    // Sem barreira entre os laços: os grupos de lanes e os arrays grandes não se sobrepõem
+    #pragma omp for schedule(dynamic, 16) nowait
+    for (int group = 0; group < group_count; ++group) {
+        int end_array = (group + 1) * BATCH_LANES;
+        batch_sort_lane_group(network, data, offsets, group * BATCH_LANES,
+                              (end_array < batch_count) ? end_array : batch_count);
+    }
+    #pragma omp for schedule(dynamic, 16)
+    for (int array_idx = 0; array_idx < batch_count; ++array_idx) {
+        long length = offsets[array_idx + 1] - offsets[array_idx];
+        if (length > BATCH_LANE_MAX_KEYS) {
+            batch_sort_single_array(kernel, data + offsets[array_idx], length);
+        }
+    }
+}
+
+// Ordena os 'batch_count' arrays de 'data' delimitados por 'offsets' (ver o início do arquivo)
+static inline void odd_even_sort_batch(int data[], const long offsets[], int batch_count) {
+    compare_exchange_kernel_fn kernel = select_compare_exchange_kernel();
+    batch_lane_network_fn network = select_batch_lane_network();
+    if (omp_in_parallel()) {
+        batch_sort_in_team(data, offsets, batch_count, kernel, network);
+        return;
+    }
+    #pragma omp parallel
+    batch_sort_in_team(data, offsets, batch_count, kernel, network);
+}
+
+#endif // ODD_EVEN_BATCH_H
@@ -0,0 +1,177 @@
+#ifndef ODD_EVEN_INCREMENTAL_H
+#define ODD_EVEN_INCREMENTAL_H
+
+// Ordenação incremental: um array mantido ordenado absorve lotes de chaves anexados ao fim, sem
+// reordenar as n chaves a cada atualização.
+//
+// Cada chamada de incremental_append:
+//   1. copia o lote para o fim do array e o ordena sozinho: cada thread ordena um trecho com
+//      sort_int e os trechos são intercalados dois a dois, com todas as threads em cada intercalação;
+//   2. localiza por busca binária o primeiro elemento do prefixo maior que a menor chave do lote;
+//      só o trecho a partir dali (o trecho afetado) é intercalado com o lote, em paralelo, e volta
+//      para o array. Se o lote inteiro for maior que o prefixo, não há intercalação.
+// O custo de uma atualização é O(m log m + afetado) para um lote de m chaves, em vez dos O(n²) de
+// reordenar tudo; em fluxos quase crescentes (carimbos de tempo, identificadores) o trecho afetado
+// é pequeno e sobra praticamente só a ordenação do lote.
+//
+// As intercalações dividem a SAÍDA em faixas iguais, uma por thread, e cada thread encontra o seu
+// ponto de partida nas duas entradas por busca binária (merge path). Os dados e a área de
+// intercalação crescem geometricamente e são reaproveitados entre as atualizações.
+//
+// Como em odd_even_batch.h, as funções de equipe (team_*) usam laços compartilhados e devem ser
+// chamadas por todas as threads de uma região paralela já aberta.
+
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include "odd_even_keys.h"
+
+typedef struct {
+    int *data;              // Prefixo ordenado com 'size' chaves, capacidade para 'capacity'
+    long size;
+    long capacity;
+    int *scratch;           // Área de intercalação reaproveitada entre atualizações
+    long scratch_capacity;
+    long moved_elements;    // Chaves do prefixo regravadas por intercalações (acumulado)
+} incremental_sorted_array;
+
+static inline void incremental_init(incremental_sorted_array *sorted) {
+    memset(sorted, 0, sizeof(*sorted));
+}
+
+static inline void incremental_free(incremental_sorted_array *sorted) {
+    free(sorted->data);
+    free(sorted->scratch);
+    incremental_init(sorted);
+}
+
+// Garante capacidade para 'needed' chaves, dobrando o buffer; retorna 0 se faltar memória
+static inline int incremental_reserve(int **buffer, long *capacity, long needed) {
+    if (needed <= *capacity) return 1;
+    long grown = (*capacity > 0) ? *capacity : 1024;
+    while (grown < needed) grown *= 2;
+    int *resized = (int *)realloc(*buffer, (size_t)grown * sizeof(int));
+    if (resized == NULL) return 0;
+    *buffer = resized;
+    *capacity = grown;
+    return 1;
+}
+
+// Merge path: quantos elementos de 'left' estão entre os 'diagonal' primeiros da intercalação de
+// 'left' com 'right' (empates favorecem 'left', o que mantém as chaves antigas antes das novas)
+static inline long merge_path_split(const int left[], long left_size, const int right[], long right_size,
+                                    long diagonal) {
+    long low = (diagonal > right_size) ? diagonal - right_size : 0;
+    long high = (diagonal < left_size) ? diagonal : left_size;
+    while (low < high) {
+        long left_count = (low + high) / 2;
+        if (left[left_count] <= right[diagonal - left_count - 1]) {
+            low = left_count + 1;
+        } else {
+            high = left_count;
+        }
+    }
+    return low;
+}
+
+// Intercala 'left' e 'right' em 'output' com a equipe atual; cada thread produz uma faixa da saída
+static inline void team_merge(const int left[], long left_size, const int right[], long right_size,
+                              int output[]) {
+    long total = left_size + right_size;
+    int parts = omp_get_num_threads();
+    #pragma omp for schedule(static)
+    for (int part = 0; part < parts; ++part) {
+        long begin = total * part / parts;
+        long end = total * (part + 1) / parts;
+        long left_idx = merge_path_split(left, left_size, right, right_size, begin);
+        long right_idx = begin - left_idx;
+        for (long out_idx = begin; out_idx < end; ++out_idx) {
+            if (right_idx < right_size && (left_idx >= left_size || right[right_idx] < left[left_idx])) {
+                output[out_idx] = right[right_idx++];
+            } else {
+                output[out_idx] = left[left_idx++];
+            }
+        }
+    }
+}
+
+// Cópia dividida entre a equipe
+static inline void team_copy(int destination[], const int source[], long count) {
+    #pragma omp for schedule(static)
+    for (long idx = 0; idx < count; ++idx) destination[idx] = source[idx];
+}
+
+// Ordena 'keys' (m chaves) com a equipe: trechos por thread com sort_int, depois intercalações dois a
+// dois alternando entre 'keys' e 'scratch'; o resultado termina em 'keys'
+static inline void team_sort_batch(int keys[], long m, int scratch[]) {
+    int run_count = omp_get_num_threads();
+    if (run_count > m) run_count = (int)m;
+    #pragma omp for schedule(static)
+    for (int run = 0; run < run_count; ++run) {
+        long first = m * run / run_count;
+        sort_int(keys + first, m * (run + 1) / run_count - first);
+    }
+    int *source = keys, *destination = scratch;
+    for (int step = 1; step < run_count; step *= 2) {
+        for (int run = 0; run < run_count; run += 2 * step) {
+            long first = m * run / run_count;
+            long middle = m * ((run + step < run_count) ? run + step : run_count) / run_count;
+            long last = m * ((run + 2 * step < run_count) ? run + 2 * step : run_count) / run_count;
+            team_merge(source + first, middle - first, source + middle, last - middle, destination + first);
+        }
+        int *previous_source = source;
+        source = destination;
+        destination = previous_source;
+    }
+    if (source != keys) team_copy(keys, source, m);
+}
+
+// Primeira posição do prefixo ordenado com chave maior que 'key'
+static inline long incremental_upper_bound(const int data[], long size, int key) {
+    long low = 0, high = size;
+    while (low < high) {
+        long middle = (low + high) / 2;
+        if (data[middle] <= key) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+// Absorve as 'batch_size' chaves de 'batch' no array ordenado usando 'num_threads' threads.
+// Retorna 0 (sem alterar o array) se faltar memória.
+static inline int incremental_append(incremental_sorted_array *sorted, const int batch[], long batch_size,
+                                     int num_threads) {
+    if (batch_size <= 0) return 1;
+    long total = sorted->size + batch_size;
+    if (!incremental_reserve(&sorted->data, &sorted->capacity, total) ||
+        !incremental_reserve(&sorted->scratch, &sorted->scratch_capacity, total)) {
+        return 0;
+    }
+    int *data = sorted->data, *scratch = sorted->scratch;
+    long prefix_size = sorted->size;
+    int *tail = data + prefix_size;
+    memcpy(tail, batch, (size_t)batch_size * sizeof(int));
+    if (num_threads > batch_size) num_threads = (int)batch_size;
+
+    long affected_start = prefix_size;
+    #pragma omp parallel num_threads(num_threads)
+    {
+        team_sort_batch(tail, batch_size, scratch);
+        // Após a barreira implícita do último laço, todas as threads calculam o mesmo ponto
+        long first = incremental_upper_bound(data, prefix_size, tail[0]);
+        if (first < prefix_size) {
+            team_merge(data + first, prefix_size - first, tail, batch_size, scratch);
+            team_copy(data + first, scratch, total - first);
+        }
+        #pragma omp single nowait
+        affected_start = first;
+    }
+    sorted->moved_elements += prefix_size - affected_start;
+    sorted->size = total;
+    return 1;
+}
+
+#endif // ODD_EVEN_INCREMENTAL_H
@@ -0,0 +1,130 @@
+#ifndef ODD_EVEN_INPUT_H
+#define ODD_EVEN_INPUT_H
+
+// Geração reprodutível dos dados de entrada, compartilhada pelas versões serial, OpenMP e MPI.
+//
+// A entrada é definida por uma distribuição e uma semente, lidas das variáveis de ambiente
+// ODD_EVEN_DIST e ODD_EVEN_SEED (usadas pelo benchmark.py). Sem ODD_EVEN_SEED a semente vem do
+// relógio, como antes, e é impressa em stderr para que a execução possa ser repetida.
+//
+// O gerador é baseado em contador: o elemento i depende só da semente, de i e do tamanho total, então
+// qualquer trecho pode ser gerado de forma independente (cada thread OpenMP ou processo MPI gera a sua
+// fatia) e o array resultante é idêntico bit a bit para qualquer número de threads ou processos.
+//
+// Distribuições:
+//   uniforme        valores uniformes em [0, 1000) (padrão, equivale ao rand() % 1000 original)
+//   ordenado        sequência já ordenada
+//   reverso         sequência em ordem decrescente
+//   quase_ordenado  ordenada, com ~1% das posições substituídas por valores aleatórios em [0, n)
+//   poucos_valores  apenas 8 valores distintos
+//   completo        faixa completa de inteiros de 32 bits (com negativos)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+typedef enum {
+    INPUT_UNIFORM,
+    INPUT_SORTED,
+    INPUT_REVERSE,
+    INPUT_NEARLY_SORTED,
+    INPUT_FEW_UNIQUE,
+    INPUT_FULL_RANGE
+} input_distribution;
+
+typedef struct {
+    input_distribution distribution;
+    uint64_t seed;
+} input_config;
+
+static const char *const input_distribution_names[] = {
+    "uniforme", "ordenado", "reverso", "quase_ordenado", "poucos_valores", "completo"
+};
+
+// Gerador SplitMix64: pequeno, rápido e com saída idêntica em qualquer plataforma
+static inline uint64_t splitmix64_next(uint64_t *state) {
+    uint64_t mixed = (*state += 0x9E3779B97F4A7C15ULL);
+    mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBULL;
+    return mixed ^ (mixed >> 31);
+}
+
+// Converte o nome da distribuição; retorna 0 se o nome for desconhecido
+static inline int parse_input_distribution(const char *name, input_distribution *distribution) {
+    for (int i = 0; i < (int)(sizeof(input_distribution_names) / sizeof(input_distribution_names[0])); ++i) {
+        if (strcmp(name, input_distribution_names[i]) == 0) {
+            *distribution = (input_distribution)i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Lê ODD_EVEN_DIST e ODD_EVEN_SEED; retorna 0 (com mensagem) se a distribuição for inválida
+static inline int read_input_config(input_config *config) {
+    const char *dist_name = getenv("ODD_EVEN_DIST");
+    const char *seed_text = getenv("ODD_EVEN_SEED");
+    config->distribution = INPUT_UNIFORM;
+    if (dist_name != NULL && !parse_input_distribution(dist_name, &config->distribution)) {
+        fprintf(stderr, "Erro: distribuição '%s' desconhecida (use uniforme, ordenado, reverso, "
+                        "quase_ordenado, poucos_valores ou completo).\n", dist_name);
+        return 0;
+    }
+    config->seed = (seed_text != NULL) ? strtoull(seed_text, NULL, 10) : (uint64_t)time(NULL);
+    return 1;
+}
+
+// Sorteio 'index' da semente: igual à (index + 1)-ésima chamada de splitmix64_next a partir de 'seed',
+// mas calculado diretamente (salto para qualquer posição)
+static inline uint64_t splitmix64_at(uint64_t seed, uint64_t index) {
+    uint64_t state = seed + index * 0x9E3779B97F4A7C15ULL;
+    return splitmix64_next(&state);
+}
+
+// Elemento 'index' de uma entrada com 'total_items' elementos
+static inline int input_value_at(const input_config *config, long index, long total_items) {
+    uint64_t draw = splitmix64_at(config->seed, (uint64_t)index);
+    switch (config->distribution) {
+    case INPUT_UNIFORM:
+        return (int)(draw % 1000);
+    case INPUT_SORTED:
+        return (int)index;
+    case INPUT_REVERSE:
+        return (int)(total_items - index);
+    case INPUT_NEARLY_SORTED:
+        return (draw % 100 == 0) ? (int)((draw >> 32) % (uint64_t)total_items) : (int)index;
+    case INPUT_FEW_UNIQUE:
+        return (int)(draw % 8) * 125;
+    case INPUT_FULL_RANGE:
+        return (int)(uint32_t)draw;
+    }
+    return 0;
+}
+
+// Preenche 'dest' com os elementos [first_index, first_index + count) de uma entrada de 'total_items'
+// elementos. Nas versões compiladas com OpenMP, trechos grandes são divididos entre as threads.
+#define INPUT_PARALLEL_MIN_ITEMS 65536
+static inline void fill_input_range(int dest[], long first_index, long count, long total_items,
+                                    const input_config *config) {
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static) if (count >= INPUT_PARALLEL_MIN_ITEMS)
+#endif
+    for (long k = 0; k < count; ++k) {
+        dest[k] = input_value_at(config, first_index + k, total_items);
+    }
+}
+
+// Preenche o array completo segundo a distribuição e a semente configuradas
+static inline void fill_input_array(int dest_array[], int total_items, const input_config *config) {
+    fill_input_range(dest_array, 0, total_items, total_items, config);
+}
+
+// Registra em stderr a configuração usada, para permitir repetir a execução
+static inline void report_input_config(const input_config *config, FILE *output_stream) {
+    fprintf(output_stream, "Entrada: distribuição %s, semente %llu\n",
+            input_distribution_names[config->distribution], (unsigned long long)config->seed);
+}
+
+#endif // ODD_EVEN_INPUT_H
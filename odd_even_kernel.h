@@ -0,0 +1,105 @@
+#ifndef ODD_EVEN_KERNEL_H
+#define ODD_EVEN_KERNEL_H
+
+// Kernel de compare-exchange das fases do Odd-Even Transposition Sort, compartilhado
+// pelas versões serial e OpenMP.
+//
+// Uma fase compara os pares (p[0], p[1]), (p[2], p[3]), ... a partir de um ponteiro base
+// (array na fase par, array + 1 na fase ímpar). Em vez de um desvio por par, cada par vira
+// um min/max sem desvios: com AVX2 são 4 pares por registro de 256 bits, com SSE4.1 são 2
+// por registro de 128 bits, e as demais CPUs usam uma versão escalar com movimentos
+// condicionais. A variante é escolhida uma única vez em tempo de execução conforme a CPU;
+// a variável de ambiente ODD_EVEN_KERNEL=avx2|sse4.1|escalar força uma delas (comparações).
+
+#include <stdlib.h>
+#include <string.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// Assinatura comum: ordena 'pair_count' pares adjacentes a partir de 'pairs'
+typedef void (*compare_exchange_kernel_fn)(int *pairs, int pair_count);
+
+// Versão escalar sem desvios (o compilador gera cmov)
+static inline void compare_exchange_pairs_scalar(int *pairs, int pair_count) {
+    for (int k = 0; k < pair_count; ++k) {
+        int left = pairs[2 * k];
+        int right = pairs[2 * k + 1];
+        pairs[2 * k] = (left < right) ? left : right;
+        pairs[2 * k + 1] = (left < right) ? right : left;
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// SSE4.1: troca os vizinhos de cada par, calcula min/max e mescla (min nas posições pares,
+// max nas ímpares)
+__attribute__((target("sse4.1")))
+static inline void compare_exchange_pairs_sse41(int *pairs, int pair_count) {
+    int k = 0;
+    for (; k + 2 <= pair_count; k += 2) {
+        __m128i values = _mm_loadu_si128((const __m128i *)(pairs + 2 * k));
+        __m128i swapped = _mm_shuffle_epi32(values, _MM_SHUFFLE(2, 3, 0, 1));
+        __m128i minimums = _mm_min_epi32(values, swapped);
+        __m128i maximums = _mm_max_epi32(values, swapped);
+        _mm_storeu_si128((__m128i *)(pairs + 2 * k), _mm_blend_epi16(minimums, maximums, 0xCC));
+    }
+    compare_exchange_pairs_scalar(pairs + 2 * k, pair_count - k);
+}
+
+// AVX2: mesma ideia com 4 pares por registro
+__attribute__((target("avx2")))
+static inline void compare_exchange_pairs_avx2(int *pairs, int pair_count) {
+    int k = 0;
+    for (; k + 4 <= pair_count; k += 4) {
+        __m256i values = _mm256_loadu_si256((const __m256i *)(pairs + 2 * k));
+        __m256i swapped = _mm256_shuffle_epi32(values, _MM_SHUFFLE(2, 3, 0, 1));
+        __m256i minimums = _mm256_min_epi32(values, swapped);
+        __m256i maximums = _mm256_max_epi32(values, swapped);
+        _mm256_storeu_si256((__m256i *)(pairs + 2 * k), _mm256_blend_epi32(minimums, maximums, 0xAA));
+    }
+    compare_exchange_pairs_scalar(pairs + 2 * k, pair_count - k);
+}
+#endif
+
+// Escolhe o kernel mais rápido suportado pela CPU atual
+static inline compare_exchange_kernel_fn select_compare_exchange_kernel(void) {
+    const char *forced_kernel = getenv("ODD_EVEN_KERNEL");
+    if (forced_kernel != NULL && strcmp(forced_kernel, "escalar") == 0) {
+        return compare_exchange_pairs_scalar;
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    int force_sse = (forced_kernel != NULL && strcmp(forced_kernel, "sse4.1") == 0);
+    if (__builtin_cpu_supports("avx2") && !force_sse) {
+        return compare_exchange_pairs_avx2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return compare_exchange_pairs_sse41;
+    }
+#endif
+    return compare_exchange_pairs_scalar;
+}
+
+// Aplica a fase 'phase' apenas aos pares (i, i+1) com i em [first_left, end_left), respeitando
+// a paridade da fase e os limites do array. Usado pelos modos ladrilhados (tiling temporal),
+// que aplicam várias fases consecutivas a um trecho do array antes de seguir para o próximo.
+static inline void apply_phase_to_range(compare_exchange_kernel_fn kernel, int array[], int n,
+                                        int phase, long first_left, long end_left) {
+    if (first_left < 0) first_left = 0;
+    if (end_left > n - 1) end_left = n - 1;
+    if ((first_left & 1) != (phase & 1)) first_left++;
+    if (first_left >= end_left) return;
+    kernel(array + first_left, (int)((end_left - first_left + 1) / 2));
+}
+
+// Nome do kernel selecionado (para relatórios)
+static inline const char *compare_exchange_kernel_name(compare_exchange_kernel_fn kernel) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (kernel == compare_exchange_pairs_avx2) return "avx2";
+    if (kernel == compare_exchange_pairs_sse41) return "sse4.1";
+#endif
+    (void)kernel;
+    return "escalar";
+}
+
+#endif // ODD_EVEN_KERNEL_H
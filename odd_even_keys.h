@@ -0,0 +1,353 @@
+#ifndef ODD_EVEN_KEYS_H
+#define ODD_EVEN_KEYS_H
+
+// Chaves tipadas e registros (chave, payload), compartilhados pelas versões serial, OpenMP e MPI.
+//
+// O núcleo do Odd-Even (fase de compare-exchange, ordenação completa, ordenação local, merge-split,
+// verificação paralela de ordem e permutação e geração da entrada) é escrito uma única vez em ODD_EVEN_DEFINE_SORT_CORE e
+// instanciado por macro para cada tipo de ODD_EVEN_KEY_TYPES, tanto para chaves puras quanto para
+// registros. Cada instância compara diretamente com '<' sobre o tipo concreto, então a comparação
+// é expandida no laço, sem a chamada por ponteiro de função do comparador do qsort. As conversões
+// que dependem do tipo (faixa dos valores gerados, formato de impressão) são escolhidas por _Generic.
+//
+// Variáveis de ambiente:
+//   ODD_EVEN_KEY=int|int64|uint32|float|double   tipo da chave (padrão int, que mantém os caminhos
+//                                                SIMD e todos os modos de cada programa)
+//   ODD_EVEN_PAYLOAD=nao|sim                     ordena registros { chave, payload de 64 bits }; o
+//                                                payload guarda a posição original do elemento e só é
+//                                                movido quando a comparação resulta em troca
+//
+// Para chaves int, a entrada gerada é idêntica à de fill_input_array (mesma distribuição e semente).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "odd_even_input.h"
+#include "odd_even_verify.h"
+
+// X(nome, tipo C): tipos de chave especializados
+#define ODD_EVEN_KEY_TYPES(X) \
+    X(int, int)               \
+    X(int64, int64_t)         \
+    X(uint32, uint32_t)       \
+    X(float, float)           \
+    X(double, double)
+
+typedef enum {
+#define KEY_TYPE_ENUM_ENTRY(name, type) KEY_TYPE_##name,
+    ODD_EVEN_KEY_TYPES(KEY_TYPE_ENUM_ENTRY)
+#undef KEY_TYPE_ENUM_ENTRY
+    KEY_TYPE_COUNT
+} key_type;
+
+static const char *const key_type_names[] = {
+#define KEY_TYPE_NAME_ENTRY(name, type) #name,
+    ODD_EVEN_KEY_TYPES(KEY_TYPE_NAME_ENTRY)
+#undef KEY_TYPE_NAME_ENTRY
+};
+
+typedef struct {
+    key_type type;
+    int with_payload;
+} key_config;
+
+// Lê ODD_EVEN_KEY e ODD_EVEN_PAYLOAD; retorna 0 (com mensagem) se algum valor for inválido
+static inline int read_key_config(key_config *config) {
+    const char *type_name = getenv("ODD_EVEN_KEY");
+    const char *payload_text = getenv("ODD_EVEN_PAYLOAD");
+    config->type = KEY_TYPE_int;
+    config->with_payload = 0;
+    if (type_name != NULL && type_name[0] != '\0') {
+        int type_idx = 0;
+        while (type_idx < KEY_TYPE_COUNT && strcmp(type_name, key_type_names[type_idx]) != 0) type_idx++;
+        if (type_idx == KEY_TYPE_COUNT) {
+            fprintf(stderr, "Erro: ODD_EVEN_KEY='%s' desconhecido (use int, int64, uint32, float ou double).\n",
+                    type_name);
+            return 0;
+        }
+        config->type = (key_type)type_idx;
+    }
+    if (payload_text != NULL && payload_text[0] != '\0') {
+        if (strcmp(payload_text, "sim") != 0 && strcmp(payload_text, "nao") != 0) {
+            fprintf(stderr, "Erro: ODD_EVEN_PAYLOAD='%s' inválido (use sim ou nao).\n", payload_text);
+            return 0;
+        }
+        config->with_payload = (strcmp(payload_text, "sim") == 0);
+    }
+    return 1;
+}
+
+// Chaves int sem payload seguem pelos caminhos originais (kernels SIMD e todos os modos)
+static inline int key_config_is_default(const key_config *config) {
+    return config->type == KEY_TYPE_int && !config->with_payload;
+}
+
+// Descrição para relatórios, por exemplo "int64" ou "registro double"
+static inline void describe_key_config(const key_config *config, char *text, size_t text_size) {
+    snprintf(text, text_size, "%s%s", config->with_payload ? "registro " : "", key_type_names[config->type]);
+}
+
+// Valor uniforme em [0, 1) a partir dos 53 bits mais altos
+static inline double key_unit_interval(uint64_t bits) {
+    return (double)(bits >> 11) * 0x1.0p-53;
+}
+
+// Valores em [0, range): inteiros como na versão int, ponto flutuante com parte fracionária
+#define KEY_FROM_SMALL_RANGE(type, bits, range) _Generic((type)0,          \
+    float: (type)(key_unit_interval(bits) * (double)(range)),              \
+    double: (type)(key_unit_interval(bits) * (double)(range)),             \
+    default: (type)((bits) % (uint64_t)(range)))
+
+// Faixa completa do tipo (com negativos nos tipos com sinal); float/double cobrem ±2^31 e ±2^52
+#define KEY_FROM_FULL_RANGE(type, bits) _Generic((type)0,                  \
+    float: (type)((double)(int64_t)(bits) * 0x1.0p-32),                    \
+    double: (type)((double)(int64_t)(bits) * 0x1.0p-11),                   \
+    int: (type)(uint32_t)(bits),                                           \
+    default: (type)(bits))
+
+static inline void print_key_int(FILE *stream, int key) { fprintf(stream, "%d ", key); }
+static inline void print_key_int64(FILE *stream, int64_t key) { fprintf(stream, "%lld ", (long long)key); }
+static inline void print_key_uint32(FILE *stream, uint32_t key) { fprintf(stream, "%u ", key); }
+static inline void print_key_float(FILE *stream, float key) { fprintf(stream, "%g ", key); }
+static inline void print_key_double(FILE *stream, double key) { fprintf(stream, "%g ", key); }
+
+#define PRINT_KEY(stream, key) _Generic((key),                             \
+    int: print_key_int, int64_t: print_key_int64, uint32_t: print_key_uint32, \
+    float: print_key_float, double: print_key_double)(stream, key)
+
+// Núcleo genérico para o elemento 'element_type' (chave ou registro) com chave 'key_type_c'.
+// Requer, já definidos para o sufixo: element_key_<s> (lê a chave), set_element_<s> (grava chave e
+// posição original), element_bits_<s> (elemento reduzido a 64 bits para a assinatura de
+// multiconjunto) e compare_exchange_<s> (ordena dois elementos).
+#define ODD_EVEN_DEFINE_SORT_CORE(s, element_type, key_type_c)                                         \
+/* Uma fase: ordena os pares (p[0], p[1]), (p[2], p[3]), ... */                                        \
+static inline void compare_exchange_pairs_##s(element_type *pairs, long pair_count) {                 \
+    for (long k = 0; k < pair_count; ++k) compare_exchange_##s(&pairs[2 * k], &pairs[2 * k + 1]);     \
+}                                                                                                      \
+                                                                                                       \
+/* Odd-Even Transposition Sort completo (n fases) */                                                   \
+static inline void odd_even_sort_##s(element_type array[], long n) {                                   \
+    for (long phase = 0; phase < n; ++phase) {                                                         \
+        compare_exchange_pairs_##s(array + (phase % 2), (n - (phase % 2)) / 2);                       \
+    }                                                                                                  \
+}                                                                                                      \
+                                                                                                       \
+/* Ordem em uma passada paralela: conta os pares vizinhos fora de ordem (odd_even_verify.h) */         \
+static inline int verify_sorted_##s(const element_type array[], long n) {                              \
+    long disordered_pairs = 0;                                                                         \
+    VERIFY_PRAGMA("omp parallel for reduction(+:disordered_pairs) if(n >= VERIFY_PARALLEL_MIN_ITEMS)") \
+    for (long i = 0; i < n - 1; ++i) {                                                                 \
+        disordered_pairs += (element_key_##s(&array[i + 1]) < element_key_##s(&array[i]));             \
+    }                                                                                                  \
+    return disordered_pairs == 0;                                                                      \
+}                                                                                                      \
+                                                                                                       \
+/* Acumula em 'checksum' a assinatura de multiconjunto dos elementos (independente da ordem) */        \
+static inline void multiset_checksum_##s(const element_type array[], long n, uint64_t checksum[]) {    \
+    uint64_t first_sum = 0, second_sum = 0;                                                            \
+    VERIFY_PRAGMA("omp parallel for reduction(+:first_sum, second_sum) if(n >= VERIFY_PARALLEL_MIN_ITEMS)") \
+    for (long i = 0; i < n; ++i) {                                                                     \
+        uint64_t bits = element_bits_##s(&array[i]);                                                   \
+        first_sum += multiset_mix_first(bits);                                                         \
+        second_sum += multiset_mix_second(bits);                                                       \
+    }                                                                                                  \
+    checksum[0] += first_sum;                                                                          \
+    checksum[1] += second_sum;                                                                         \
+}                                                                                                      \
+                                                                                                       \
+static inline void insertion_sort_##s(element_type array[], long n) {                                  \
+    for (long i = 1; i < n; ++i) {                                                                     \
+        element_type held = array[i];                                                                  \
+        long j = i;                                                                                    \
+        while (j > 0 && element_key_##s(&held) < element_key_##s(&array[j - 1])) {                     \
+            array[j] = array[j - 1];                                                                   \
+            j--;                                                                                       \
+        }                                                                                              \
+        array[j] = held;                                                                               \
+    }                                                                                                  \
+}                                                                                                      \
+                                                                                                       \
+static inline void heap_sift_down_##s(element_type array[], long root, long n) {                      \
+    element_type held = array[root];                                                                   \
+    for (long child = 2 * root + 1; child < n; child = 2 * root + 1) {                                 \
+        if (child + 1 < n && element_key_##s(&array[child]) < element_key_##s(&array[child + 1])) {   \
+            child++;                                                                                   \
+        }                                                                                              \
+        if (!(element_key_##s(&held) < element_key_##s(&array[child]))) break;                        \
+        array[root] = array[child];                                                                    \
+        root = child;                                                                                  \
+    }                                                                                                  \
+    array[root] = held;                                                                                \
+}                                                                                                      \
+                                                                                                       \
+static inline void heap_sort_##s(element_type array[], long n) {                                       \
+    for (long root = n / 2 - 1; root >= 0; --root) heap_sift_down_##s(array, root, n);                \
+    for (long end = n - 1; end > 0; --end) {                                                           \
+        element_type top = array[0];                                                                   \
+        array[0] = array[end];                                                                         \
+        array[end] = top;                                                                              \
+        heap_sift_down_##s(array, 0, end);                                                             \
+    }                                                                                                  \
+}                                                                                                      \
+                                                                                                       \
+/* Introsort: quicksort com mediana de três, heapsort se a recursão degenerar, inserção no fim */      \
+static inline void introsort_loop_##s(element_type array[], long n, int depth_limit) {                       \
+    while (n > 16) {                                                                                   \
+        if (depth_limit-- == 0) {                                                                      \
+            heap_sort_##s(array, n);                                                                   \
+            return;                                                                                    \
+        }                                                                                              \
+        long middle = n / 2;                                                                           \
+        compare_exchange_##s(&array[0], &array[middle]);                                               \
+        compare_exchange_##s(&array[middle], &array[n - 1]);                                           \
+        compare_exchange_##s(&array[0], &array[middle]);                                               \
+        key_type_c pivot = element_key_##s(&array[middle]);                                           \
+        long left = 0, right = n - 1;                                                                  \
+        for (;;) {                                                                                     \
+            while (element_key_##s(&array[left]) < pivot) left++;                                      \
+            while (pivot < element_key_##s(&array[right])) right--;                                    \
+            if (left >= right) break;                                                                  \
+            element_type held = array[left];                                                           \
+            array[left++] = array[right];                                                              \
+            array[right--] = held;                                                                     \
+        }                                                                                              \
+        /* Recursão na parte menor, laço na maior: profundidade de pilha O(log n) */                   \
+        long split = right + 1;                                                                        \
+        if (split < n - split) {                                                                       \
+            introsort_loop_##s(array, split, depth_limit);                                             \
+            array += split;                                                                            \
+            n -= split;                                                                                \
+        } else {                                                                                       \
+            introsort_loop_##s(array + split, n - split, depth_limit);                                 \
+            n = split;                                                                                 \
+        }                                                                                              \
+    }                                                                                                  \
+}                                                                                                      \
+                                                                                                       \
+/* Ordenação local (substitui o qsort com comparador) */                                               \
+static inline void sort_##s(element_type array[], long n) {                                           \
+    int depth_limit = 0;                                                                               \
+    for (long size = n; size > 1; size >>= 1) depth_limit += 2;                                        \
+    introsort_loop_##s(array, n, depth_limit);                                                         \
+    insertion_sort_##s(array, n);                                                                      \
+}                                                                                                      \
+                                                                                                       \
+/* Merge-split: grava em 'output' os 'own_size' menores (keep_lower) ou maiores elementos da           \
+   intercalação dos blocos ordenados; retorna quantos vieram do vizinho */                             \
+static inline long merge_split_##s(const element_type own[], long own_size, const element_type partner[], \
+                                   long partner_size, element_type output[], int keep_lower) {         \
+    long moved = 0;                                                                                    \
+    if (keep_lower) {                                                                                  \
+        long own_idx = 0, partner_idx = 0;                                                             \
+        for (long out_idx = 0; out_idx < own_size; ++out_idx) {                                        \
+            if (partner_idx < partner_size &&                                                          \
+                element_key_##s(&partner[partner_idx]) < element_key_##s(&own[own_idx])) {             \
+                output[out_idx] = partner[partner_idx++];                                              \
+                moved++;                                                                               \
+            } else {                                                                                   \
+                output[out_idx] = own[own_idx++];                                                      \
+            }                                                                                          \
+        }                                                                                              \
+    } else {                                                                                           \
+        long own_idx = own_size - 1, partner_idx = partner_size - 1;                                   \
+        for (long out_idx = own_size - 1; out_idx >= 0; --out_idx) {                                   \
+            if (partner_idx >= 0 &&                                                                    \
+                element_key_##s(&own[own_idx]) < element_key_##s(&partner[partner_idx])) {            \
+                output[out_idx] = partner[partner_idx--];                                              \
+                moved++;                                                                               \
+            } else {                                                                                   \
+                output[out_idx] = own[own_idx--];                                                      \
+            }                                                                                          \
+        }                                                                                              \
+    }                                                                                                  \
+    return moved;                                                                                      \
+}                                                                                                      \
+                                                                                                       \
+/* Elemento 'index' da entrada, pelo mesmo sorteio por contador de input_value_at */                   \
+static inline key_type_c key_value_at_##s(const input_config *config, long index, long total) {        \
+    uint64_t draw = splitmix64_at(config->seed, (uint64_t)index);                                      \
+    switch (config->distribution) {                                                                    \
+    case INPUT_UNIFORM:                                                                                \
+        return KEY_FROM_SMALL_RANGE(key_type_c, draw, 1000);                                           \
+    case INPUT_SORTED:                                                                                 \
+        return (key_type_c)index;                                                                      \
+    case INPUT_REVERSE:                                                                                \
+        return (key_type_c)(total - index);                                                            \
+    case INPUT_NEARLY_SORTED:                                                                          \
+        return (draw % 100 == 0) ? (key_type_c)((draw >> 32) % (uint64_t)total) : (key_type_c)index;   \
+    case INPUT_FEW_UNIQUE:                                                                             \
+        return (key_type_c)((draw % 8) * 125);                                                         \
+    case INPUT_FULL_RANGE:                                                                             \
+        return KEY_FROM_FULL_RANGE(key_type_c, draw);                                                  \
+    }                                                                                                  \
+    return (key_type_c)0;                                                                              \
+}                                                                                                      \
+                                                                                                       \
+/* Elementos [first_index, first_index + count) de uma entrada de 'total' elementos; o payload         \
+   guarda a posição global, então qualquer fatia pode ser gerada de forma independente */              \
+static inline void fill_range_##s(element_type dest[], long first_index, long count, long total,       \
+                                  const input_config *config) {                                        \
+    for (long k = 0; k < count; ++k) {                                                                 \
+        set_element_##s(&dest[k], key_value_at_##s(config, first_index + k, total), first_index + k);  \
+    }                                                                                                  \
+}                                                                                                      \
+                                                                                                       \
+static inline void fill_##s(element_type dest[], long n, const input_config *config) {                 \
+    fill_range_##s(dest, 0, n, n, config);                                                             \
+}                                                                                                      \
+                                                                                                       \
+/* Exibe até 20 chaves */                                                                              \
+static inline void display_segment_##s(const element_type array[], long n, FILE *stream) {            \
+    long display_limit = (n > 20) ? 20 : n;                                                            \
+    for (long i = 0; i < display_limit; ++i) PRINT_KEY(stream, element_key_##s(&array[i]));           \
+    fprintf(stream, (n > 20) ? "... (exibindo apenas os 20 primeiros elementos)\n" : "\n");           \
+}
+
+// Chaves puras e registros de um tipo. A fase das chaves usa min/max sem desvios; a dos registros
+// só copia os registros quando a comparação pede a troca, em vez de sempre regravar chave e payload.
+#define ODD_EVEN_DEFINE_KEY_TYPE(name, type)                                                           \
+typedef struct {                                                                                       \
+    type key;                                                                                          \
+    int64_t payload; /* Posição original do elemento na entrada */                                     \
+} record_##name;                                                                                       \
+                                                                                                       \
+static inline type element_key_##name(const type *element) { return *element; }                       \
+static inline void set_element_##name(type *element, type key, long index) {                          \
+    (void)index;                                                                                       \
+    *element = key;                                                                                    \
+}                                                                                                      \
+static inline uint64_t element_bits_##name(const type *element) {                                     \
+    uint64_t bits = 0;                                                                                 \
+    memcpy(&bits, element, sizeof(type));                                                              \
+    return bits;                                                                                       \
+}                                                                                                      \
+static inline void compare_exchange_##name(type *first, type *second) {                               \
+    type left = *first, right = *second;                                                               \
+    *first = (right < left) ? right : left;                                                            \
+    *second = (right < left) ? left : right;                                                           \
+}                                                                                                      \
+                                                                                                       \
+static inline type element_key_record_##name(const record_##name *element) { return element->key; }   \
+static inline void set_element_record_##name(record_##name *element, type key, long index) {          \
+    element->key = key;                                                                                \
+    element->payload = index;                                                                          \
+}                                                                                                      \
+/* O payload entra misturado, para que a assinatura só se mantenha se chave e payload seguirem juntos */ \
+static inline uint64_t element_bits_record_##name(const record_##name *element) {                     \
+    return element_bits_##name(&element->key) ^ splitmix64_at(0x3C6EF372FE94F82BULL, (uint64_t)element->payload); \
+}                                                                                                      \
+static inline void compare_exchange_record_##name(record_##name *first, record_##name *second) {      \
+    if (second->key < first->key) {                                                                    \
+        record_##name held = *first;                                                                   \
+        *first = *second;                                                                              \
+        *second = held;                                                                                \
+    }                                                                                                  \
+}                                                                                                      \
+                                                                                                       \
+ODD_EVEN_DEFINE_SORT_CORE(name, type, type)                                                            \
+ODD_EVEN_DEFINE_SORT_CORE(record_##name, record_##name, type)
+
+ODD_EVEN_KEY_TYPES(ODD_EVEN_DEFINE_KEY_TYPE)
+
+#endif // ODD_EVEN_KEYS_H
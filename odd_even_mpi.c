@@ -1,17 +1,17 @@
 #include <stdio.h>
-#include <stdlib.h>   // Para malloc, free, qsort, atoi, EXIT_SUCCESS/EXIT_FAILURE
-#include <time.h>     // Para time() em srand
+#include <stdlib.h>   // Para malloc, free, atoi, EXIT_SUCCESS/EXIT_FAILURE
 #include <mpi.h>      // Para funções MPI
-#include <stdint.h>   // Para tipos inteiros (embora não diretamente usados aqui, mantido por ser do original)
-#include <string.h>   // Para memset (não usado no original, mas útil se adicionado)
+#include <stdint.h>   // Para tipos inteiros de largura fixa
+#include <string.h>   // Para memcpy e strcmp
 #include <stdbool.h>  // Para tipo bool
-
-// Função para trocar os valores de duas variáveis inteiras
-void exchange_values(int *ptr_val_a, int *ptr_val_b) {
-    int temporary_holder = *ptr_val_a;
-    *ptr_val_a = *ptr_val_b;
-    *ptr_val_b = temporary_holder;
-}
+#include <stddef.h>   // Para offsetof (tipos MPI dos registros)
+#include <sched.h>    // Para sched_yield (espera no modo compartilhado)
+#include "odd_even_input.h" // Entrada reprodutível (distribuição e semente)
+#include "odd_even_trace.h" // Instrumentação opcional (ODD_EVEN_TRACE / ODD_EVEN_PERF)
+#include "odd_even_keys.h"  // Chaves tipadas e registros (ODD_EVEN_KEY / ODD_EVEN_PAYLOAD)
+#ifdef _OPENMP
+#include <omp.h>      // Versão híbrida (alvo odd_even_hybrid): threads dentro de cada processo
+#endif
 
 // Exibe um segmento do array (primeiros 20 elementos ou o total se menor)
 void display_array_segment(int target_array[], int array_length, FILE *output_stream) {
@@ -26,50 +26,261 @@ void display_array_segment(int target_array[], int array_length, FILE *output_st
     }
 }
 
-// Função de comparação para qsort (ordem crescente)
-int integer_comparator(const void* val1_ptr, const void* val2_ptr) {
-    int arg1 = *(const int*)val1_ptr;
-    int arg2 = *(const int*)val2_ptr;
-    if (arg1 < arg2) return -1;
-    if (arg1 > arg2) return 1;
-    return 0;
+// Operações sobre blocos locais usadas pelos motores de troca de blocos, geradas para cada elemento de
+// odd_even_keys.h (as chaves int são só mais uma instanciação): ordenação local, merge-split com o
+// bloco do vizinho e teste de convergência.
+#ifdef _OPENMP
+// ---------------------------------------------------------------------------------------------
+// Versão híbrida: quando compilado com -fopenmp (alvo odd_even_hybrid), as trocas de blocos
+// continuam entre processos MPI, mas a ordenação local e as intercalações do merge-split são
+// divididas entre as threads OpenMP de cada processo. Apenas a thread mestre chama MPI
+// (MPI_THREAD_FUNNELED).
+// ---------------------------------------------------------------------------------------------
+//
+// merge_path_partition_<tipo>: quantos elementos de 'left' estão entre os 'diagonal' primeiros da
+// intercalação de 'left' com 'right' (empates favorecem 'left').
+// merge_rank_range_<tipo>: grava em 'output' as posições [first_rank, first_rank + count) da intercalação.
+// parallel_merge_rank_range_<tipo>: divide as posições de saída entre as threads; cada uma localiza seu
+// ponto de partida por busca binária.
+// block_local_sort_<tipo>: cada thread ordena um trecho com sort_<tipo> e os trechos são intercalados
+// dois a dois (todas as threads cooperam em cada intercalação), usando 'scratch' como área auxiliar.
+// merge_split_with_partner_<tipo>: a intercalação é sempre (bloco da esquerda, bloco da direita); o
+// processo da esquerda fica com as primeiras posições e o da direita com as últimas. A quantidade de
+// elementos que mudaram de bloco só é calculada se 'count_moves' (instrumentação ativa).
+#define DEFINE_LOCAL_BLOCK_OPS(suffix, element_type)                                                   \
+int merge_path_partition_##suffix(const element_type left[], int left_size, const element_type right[], \
+                                  int right_size, long diagonal) {                                     \
+    long low = (diagonal > right_size) ? diagonal - right_size : 0;                                    \
+    long high = (diagonal < left_size) ? diagonal : left_size;                                         \
+    while (low < high) {                                                                               \
+        long left_count = (low + high) / 2;                                                            \
+        if (element_key_##suffix(&left[left_count]) <= element_key_##suffix(&right[diagonal - left_count - 1])) { \
+            low = left_count + 1;                                                                      \
+        } else {                                                                                       \
+            high = left_count;                                                                         \
+        }                                                                                              \
+    }                                                                                                  \
+    return (int)low;                                                                                   \
+}                                                                                                      \
+                                                                                                       \
+void merge_rank_range_##suffix(const element_type left[], int left_size, const element_type right[],   \
+                               int right_size, element_type output[], long first_rank, long count) {   \
+    int left_idx = merge_path_partition_##suffix(left, left_size, right, right_size, first_rank);      \
+    int right_idx = (int)(first_rank - left_idx);                                                      \
+    for (long out_idx = 0; out_idx < count; ++out_idx) {                                               \
+        if (right_idx < right_size && (left_idx >= left_size ||                                        \
+                                       element_key_##suffix(&right[right_idx]) < element_key_##suffix(&left[left_idx]))) { \
+            output[out_idx] = right[right_idx++];                                                      \
+        } else {                                                                                       \
+            output[out_idx] = left[left_idx++];                                                        \
+        }                                                                                              \
+    }                                                                                                  \
+}                                                                                                      \
+                                                                                                       \
+void parallel_merge_rank_range_##suffix(const element_type left[], int left_size, const element_type right[], \
+                                        int right_size, element_type output[], long first_rank, long count) { \
+    _Pragma("omp parallel")                                                                            \
+    {                                                                                                  \
+        int thread_id = omp_get_thread_num();                                                          \
+        int thread_total = omp_get_num_threads();                                                      \
+        long begin = count * thread_id / thread_total;                                                 \
+        long end = count * (thread_id + 1) / thread_total;                                             \
+        merge_rank_range_##suffix(left, left_size, right, right_size, output + begin, first_rank + begin, \
+                                  end - begin);                                                        \
+    }                                                                                                  \
+}                                                                                                      \
+                                                                                                       \
+void block_local_sort_##suffix(element_type data[], int size, element_type scratch[]) {                \
+    int run_count = omp_get_max_threads();                                                             \
+    if (run_count > size) run_count = (size > 0) ? size : 1;                                           \
+    int *run_bounds = (int *)malloc((run_count + 1) * sizeof(int));                                    \
+    if (run_bounds == NULL) {                                                                          \
+        fprintf(stderr, "Erro: Falha na alocação para a ordenação local paralela.\n");                 \
+        MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);                                                       \
+    }                                                                                                  \
+    for (int run = 0; run <= run_count; ++run) {                                                       \
+        run_bounds[run] = (int)((long long)size * run / run_count);                                    \
+    }                                                                                                  \
+    _Pragma("omp parallel for schedule(static)")                                                       \
+    for (int run = 0; run < run_count; ++run) {                                                        \
+        sort_##suffix(data + run_bounds[run], run_bounds[run + 1] - run_bounds[run]);                  \
+    }                                                                                                  \
+    element_type *source = data, *destination = scratch;                                               \
+    for (int step = 1; step < run_count; step *= 2) {                                                  \
+        for (int run = 0; run < run_count; run += 2 * step) {                                          \
+            int first = run_bounds[run];                                                               \
+            int middle = run_bounds[(run + step < run_count) ? run + step : run_count];                \
+            int last = run_bounds[(run + 2 * step < run_count) ? run + 2 * step : run_count];          \
+            parallel_merge_rank_range_##suffix(source + first, middle - first, source + middle, last - middle, \
+                                               destination + first, 0, last - first);                  \
+        }                                                                                              \
+        element_type *previous_source = source;                                                        \
+        source = destination;                                                                          \
+        destination = previous_source;                                                                 \
+    }                                                                                                  \
+    if (source != data) {                                                                              \
+        memcpy(data, source, size * sizeof(element_type));                                             \
+    }                                                                                                  \
+    free(run_bounds);                                                                                  \
+}                                                                                                      \
+                                                                                                       \
+long merge_split_with_partner_##suffix(const element_type own_block[], int own_size,                   \
+                                       const element_type partner_block[], int partner_size,           \
+                                       element_type output[], bool keep_lower, int count_moves) {      \
+    if (keep_lower) {                                                                                  \
+        parallel_merge_rank_range_##suffix(own_block, own_size, partner_block, partner_size, output, 0, own_size); \
+        return count_moves ? own_size - merge_path_partition_##suffix(own_block, own_size, partner_block, \
+                                                                      partner_size, own_size) : 0;     \
+    }                                                                                                  \
+    parallel_merge_rank_range_##suffix(partner_block, partner_size, own_block, own_size, output, partner_size, \
+                                       own_size);                                                      \
+    return count_moves ? partner_size - merge_path_partition_##suffix(partner_block, partner_size, own_block, \
+                                                                      own_size, partner_size) : 0;     \
+}
+#else
+// Versão só MPI: ordenação local com sort_<tipo> e merge-split sequencial (merge_split_<tipo>)
+#define DEFINE_LOCAL_BLOCK_OPS(suffix, element_type)                                                   \
+void block_local_sort_##suffix(element_type data[], int size, element_type scratch[]) {                \
+    (void)scratch;                                                                                     \
+    sort_##suffix(data, size);                                                                         \
+}                                                                                                      \
+                                                                                                       \
+long merge_split_with_partner_##suffix(const element_type own_block[], int own_size,                   \
+                                       const element_type partner_block[], int partner_size,           \
+                                       element_type output[], bool keep_lower, int count_moves) {      \
+    (void)count_moves;                                                                                 \
+    return merge_split_##suffix(own_block, own_size, partner_block, partner_size, output, keep_lower); \
+}
+#endif
+
+// traced_local_sort_<tipo>: ordenação inicial do bloco, registrada na instrumentação.
+// blocks_globally_ordered_<tipo>: teste de convergência para blocos de tamanhos diferentes (onde
+// 'total_processes' fases não bastam): cada processo compara seu maior elemento com o menor do vizinho
+// da direita e o resultado é combinado com MPI_Allreduce. Retorna true se o array global já está ordenado.
+#define DEFINE_BLOCK_OPS(suffix, element_type)                                                         \
+DEFINE_LOCAL_BLOCK_OPS(suffix, element_type)                                                           \
+                                                                                                       \
+void traced_local_sort_##suffix(element_type data[], int size, element_type scratch[]) {               \
+    int tracing = trace_enabled();                                                                     \
+    double sort_start = tracing ? trace_now_us() : 0.0;                                                \
+    block_local_sort_##suffix(data, size, scratch);                                                    \
+    if (tracing) trace_record(0, TRACE_LOCAL_SORT, -1, sort_start, trace_now_us(), 0.0, 0, 0, 0);      \
+}                                                                                                      \
+                                                                                                       \
+bool blocks_globally_ordered_##suffix(const element_type block[], int block_size, int total_processes, \
+                                      int current_rank, MPI_Datatype element_datatype,                 \
+                                      double *communication_time) {                                    \
+    element_type right_minimum = block[block_size - 1];                                                \
+    int left_partner = (current_rank > 0) ? current_rank - 1 : MPI_PROC_NULL;                          \
+    int right_partner = (current_rank < total_processes - 1) ? current_rank + 1 : MPI_PROC_NULL;       \
+    double comm_start_time = MPI_Wtime();                                                              \
+    double trace_start = trace_enabled() ? trace_now_us() : 0.0;                                       \
+    MPI_Sendrecv(&block[0], 1, element_datatype, left_partner, 1,                                      \
+                 &right_minimum, 1, element_datatype, right_partner, 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE); \
+    int locally_disordered = (right_partner != MPI_PROC_NULL &&                                        \
+                              element_key_##suffix(&right_minimum) < element_key_##suffix(&block[block_size - 1])); \
+    int globally_disordered;                                                                           \
+    MPI_Allreduce(&locally_disordered, &globally_disordered, 1, MPI_INT, MPI_LOR, MPI_COMM_WORLD);     \
+    *communication_time += MPI_Wtime() - comm_start_time;                                              \
+    if (trace_enabled()) {                                                                             \
+        trace_record(0, TRACE_REDUCE, -1, trace_start, trace_now_us(), 0.0, 0, 0,                      \
+                     (left_partner != MPI_PROC_NULL) ? (long long)sizeof(element_type) : 0);           \
+    }                                                                                                  \
+    return !globally_disordered;                                                                       \
 }
 
-// Preenche um array com números inteiros aleatórios
-void fill_with_random_elements(int destination_array[], int element_count, int max_value_limit) {
-    srand(time(NULL)); // Inicializa o gerador de números aleatórios com base no tempo atual
-    for (int i = 0; i < element_count; ++i) {
-        destination_array[i] = rand() % max_value_limit;
+#define DEFINE_BLOCK_OPS_FOR_KEY(name, type)                                                           \
+    DEFINE_BLOCK_OPS(name, type)                                                                       \
+    DEFINE_BLOCK_OPS(record_##name, record_##name)
+
+ODD_EVEN_KEY_TYPES(DEFINE_BLOCK_OPS_FOR_KEY)
+
+// Divide 'total_elements' entre os processos proporcionalmente a 'weights' (NULL = partes iguais),
+// garantindo pelo menos um elemento por processo. Preenche contagens e deslocamentos para
+// MPI_Scatterv/MPI_Gatherv.
+void compute_block_partition(int total_elements, int total_processes, const double weights[],
+                             int block_counts[], int block_displs[]) {
+    double weight_sum = 0.0;
+    for (int rank = 0; rank < total_processes; ++rank) {
+        weight_sum += (weights != NULL) ? weights[rank] : 1.0;
+    }
+    // Cada processo recebe 1 elemento garantido e o restante é repartido pelos pesos acumulados
+    int distributable = total_elements - total_processes;
+    double cumulative_weight = 0.0;
+    int previous_boundary = 0;
+    for (int rank = 0; rank < total_processes; ++rank) {
+        cumulative_weight += (weights != NULL) ? weights[rank] : 1.0;
+        int boundary = (rank == total_processes - 1) ? distributable
+                                                     : (int)((double)distributable * cumulative_weight / weight_sum);
+        block_counts[rank] = 1 + boundary - previous_boundary;
+        previous_boundary = boundary;
+    }
+    block_displs[0] = 0;
+    for (int rank = 1; rank < total_processes; ++rank) {
+        block_displs[rank] = block_displs[rank - 1] + block_counts[rank - 1];
     }
 }
 
-// Verifica se os elementos de um array estão em ordem não decrescente
-int check_if_data_is_sorted(int input_data[], int total_elements) {
-    for (int i = 0; i < total_elements - 1; ++i) {
-        if (input_data[i] > input_data[i + 1]) {
-            return 0; // O array NÃO está ordenado
+// Calibração: mede quantos elementos por segundo este processo ordena localmente (mesma rotina
+// usada pela ordenação). Usado para o particionamento ponderado (ODD_EVEN_PARTITION=calibrada).
+double calibrate_local_sort_speed(void) {
+    const int calibration_size = 1 << 18;
+    int *sample = (int *)malloc(calibration_size * sizeof(int));
+    int *scratch = (int *)malloc(calibration_size * sizeof(int));
+    if (sample == NULL || scratch == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação para a calibração.\n");
+        MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+    }
+    double best_time = 0.0;
+    for (int repetition = 0; repetition < 3; ++repetition) {
+        uint64_t rng_state = 12345;
+        for (int i = 0; i < calibration_size; ++i) {
+            sample[i] = (int)(uint32_t)splitmix64_next(&rng_state);
         }
+        double start_time = MPI_Wtime();
+        block_local_sort_int(sample, calibration_size, scratch);
+        double elapsed = MPI_Wtime() - start_time;
+        if (repetition == 0 || elapsed < best_time) best_time = elapsed;
     }
-    return 1; // O array está corretamente ordenado
+    free(sample);
+    free(scratch);
+    return (best_time > 0.0) ? calibration_size / best_time : 1.0;
+}
+
+// Verdadeiro se todos os processos têm blocos do mesmo tamanho
+bool partition_is_uniform(const int block_counts[], int total_processes) {
+    for (int rank = 1; rank < total_processes; ++rank) {
+        if (block_counts[rank] != block_counts[0]) return false;
+    }
+    return true;
 }
 
 // Implementação do Odd-Even Transposition Sort utilizando MPI
-double parallel_odd_even_sort_mpi(int local_array_segment[], int global_sorted_array_ptr[],
-                                  int total_global_elements, int local_segment_size,
+double parallel_odd_even_sort_mpi(int local_array_segment[], int total_global_elements, const int block_counts[],
                                   int total_processes, int current_rank) {
     double communication_duration_sum = 0.0; // Tempo acumulado de comunicação
+    int local_segment_size = block_counts[current_rank];
     int boundary_value;
     bool local_swap_occurred;
     int global_swaps_count;
+    int tracing = trace_enabled();
 
-    // Primeiro, ordena o segmento local usando qsort
-    qsort(local_array_segment, local_segment_size, sizeof(int), integer_comparator);
+    // Primeiro, ordena o segmento local (introsort especializado para int, sem comparador)
+    double sort_start = tracing ? trace_now_us() : 0.0;
+    sort_int(local_array_segment, local_segment_size);
+    if (tracing) trace_record(0, TRACE_LOCAL_SORT, -1, sort_start, trace_now_us(), 0.0, 0, 0, 0);
 
     // Loop principal de fases para a ordenação Odd-Even
     for (int sort_iteration = 0; sort_iteration < total_global_elements; ++sort_iteration) {
         local_swap_occurred = false; // Reinicia o flag de troca local para a fase atual
+        // Sem vizinho na fase, nenhum elemento é enviado (o mesmo teste usado abaixo)
+        int has_partner = (sort_iteration % 2 == 0)
+                          ? ((current_rank % 2 == 0 && current_rank != total_processes - 1) || current_rank % 2 != 0)
+                          : ((current_rank % 2 != 0 && current_rank != total_processes - 1) ||
+                             (current_rank % 2 == 0 && current_rank != 0));
 
         double comm_start_time = MPI_Wtime(); // Início da medição de tempo de comunicação
+        double trace_exchange_start = tracing ? trace_now_us() : 0.0;
 
         // Fase Par: Processos pares comunicam com processos ímpares à direita
         if (sort_iteration % 2 == 0) {
@@ -115,6 +326,11 @@ double parallel_odd_even_sort_mpi(int local_array_segment[], int global_sorted_a
         }
         double comm_end_time = MPI_Wtime(); // Fim da medição de tempo de comunicação
         communication_duration_sum += (comm_end_time - comm_start_time); // Acumula tempo de comunicação
+        double trace_phase_start = tracing ? trace_now_us() : 0.0;
+        if (tracing && has_partner) {
+            trace_record(0, TRACE_EXCHANGE, sort_iteration, trace_exchange_start, trace_phase_start, 0.0, 0, 0,
+                         (long long)sizeof(int));
+        }
 
         // Se uma troca ocorreu, o array local pode ter perdido a ordem interna.
         // Reordena o array local para manter a propriedade de estar localmente ordenado.
@@ -133,34 +349,1114 @@ double parallel_odd_even_sort_mpi(int local_array_segment[], int global_sorted_a
 
         // Realiza um Allreduce para somar o número de trocas em todos os processos.
         // Isso determina se o algoritmo pode parar mais cedo.
+        double trace_reduce_start = tracing ? trace_now_us() : 0.0;
         MPI_Allreduce(&local_swap_occurred, &global_swaps_count, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+        if (tracing) {
+            trace_record(0, TRACE_PHASE, sort_iteration, trace_phase_start, trace_reduce_start, 0.0,
+                         has_partner, local_swap_occurred, 0);
+            trace_record(0, TRACE_REDUCE, sort_iteration, trace_reduce_start, trace_now_us(), 0.0, 0, 0, 0);
+        }
         if (global_swaps_count == 0) {
             break; // Se nenhuma troca ocorreu em toda a rede, o array está ordenado globalmente
         }
     } // Fim do loop de fases
 
-    // Coleta todos os segmentos locais no processo raiz (rank 0) para formar o array global ordenado
-    MPI_Gather(local_array_segment, local_segment_size, MPI_INT,
-               global_sorted_array_ptr, local_segment_size, MPI_INT, 0, MPI_COMM_WORLD);
-
     return communication_duration_sum; // Retorna o tempo total de comunicação para este processo
 }
 
+// Odd-Even por blocos com comunicação não bloqueante e sobreposta ao merge.
+// Cada troca é dividida em pedaços de 'chunk_elements' elementos enviados com MPI_Isend/MPI_Irecv na
+// ordem em que o vizinho precisa deles (o processo da esquerda envia do maior para o menor, o da
+// direita do menor para o maior). O merge-split consome cada pedaço assim que ele chega, enquanto os
+// seguintes ainda estão em trânsito. A convergência é testada a cada 'check_interval' fases com um
+// MPI_Iallreduce, cujo resultado só é consultado ao fim da janela seguinte (fora do caminho crítico).
+// Retorna o tempo gasto esperando a comunicação.
+double parallel_odd_even_sort_mpi_overlapped(int local_array_segment[], const int block_counts[],
+                                             int total_processes, int current_rank,
+                                             int chunk_elements, int check_interval) {
+    double communication_wait_sum = 0.0; // Tempo bloqueado em MPI_Wait*
+    int local_segment_size = block_counts[current_rank];
+    int largest_block = 0;
+    for (int rank = 0; rank < total_processes; ++rank) {
+        if (block_counts[rank] > largest_block) largest_block = block_counts[rank];
+    }
+    bool uniform_blocks = partition_is_uniform(block_counts, total_processes);
+    int send_chunk_count = (local_segment_size + chunk_elements - 1) / chunk_elements;
+    int max_chunk_count = (largest_block + chunk_elements - 1) / chunk_elements;
+
+    int *partner_block = (int *)malloc(largest_block * sizeof(int));
+    int *merge_buffer = (int *)malloc(largest_block * sizeof(int));
+    MPI_Request *recv_requests = (MPI_Request *)malloc(max_chunk_count * sizeof(MPI_Request));
+    MPI_Request *send_requests = (MPI_Request *)malloc(max_chunk_count * sizeof(MPI_Request));
+    if (partner_block == NULL || merge_buffer == NULL || recv_requests == NULL || send_requests == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação dos buffers de troca no rank %d.\n", current_rank);
+        MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+    }
+    int *current_block = local_array_segment;
+    int tracing = trace_enabled();
+
+    traced_local_sort_int(current_block, local_segment_size, merge_buffer);
+
+    // Estado do teste de convergência preguiçoso
+    int window_changed = 0, pending_window_changed = 0, global_window_changed = 1;
+    MPI_Request convergence_request = MPI_REQUEST_NULL;
+
+    int phase_limit = total_processes;
+    for (int sort_iteration = 0; ; ++sort_iteration) {
+        if (sort_iteration >= phase_limit) {
+            // Blocos de tamanhos diferentes podem exigir fases extras (ver parallel_odd_even_sort_mpi_blocks_<tipo>)
+            if (uniform_blocks || blocks_globally_ordered_int(current_block, local_segment_size, total_processes,
+                                                              current_rank, MPI_INT, &communication_wait_sum)) {
+                break;
+            }
+            phase_limit += 2;
+        }
+        int partner_rank = (sort_iteration % 2 == current_rank % 2) ? current_rank + 1 : current_rank - 1;
+
+        if (partner_rank >= 0 && partner_rank < total_processes) {
+            int keep_lower = current_rank < partner_rank;
+            int partner_size = block_counts[partner_rank];
+            int recv_chunk_count = (partner_size + chunk_elements - 1) / chunk_elements;
+            double trace_merge_start = tracing ? trace_now_us() : 0.0;
+            double wait_before_merge = communication_wait_sum;
+
+            // Pedaço c cobre [c * chunk_elements, min((c + 1) * chunk_elements, tamanho)); a tag é o índice
+            for (int chunk = 0; chunk < recv_chunk_count; ++chunk) {
+                int chunk_start = chunk * chunk_elements;
+                int chunk_size = (partner_size - chunk_start < chunk_elements) ? partner_size - chunk_start
+                                                                               : chunk_elements;
+                MPI_Irecv(partner_block + chunk_start, chunk_size, MPI_INT, partner_rank, chunk,
+                          MPI_COMM_WORLD, &recv_requests[chunk]);
+            }
+            for (int order = 0; order < send_chunk_count; ++order) {
+                int chunk = keep_lower ? send_chunk_count - 1 - order : order;
+                int chunk_start = chunk * chunk_elements;
+                int chunk_size = (local_segment_size - chunk_start < chunk_elements) ? local_segment_size - chunk_start
+                                                                                     : chunk_elements;
+                MPI_Isend(current_block + chunk_start, chunk_size, MPI_INT, partner_rank, chunk,
+                          MPI_COMM_WORLD, &send_requests[order]);
+            }
+
+            int block_changed = 0, moved_elements = 0;
+            if (keep_lower) {
+                // Consome os pedaços do vizinho em ordem crescente
+                int own_idx = 0, partner_idx = 0, partner_available = 0, next_chunk = 0;
+                for (int out_idx = 0; out_idx < local_segment_size; ++out_idx) {
+                    if (partner_idx < partner_size && partner_idx >= partner_available) {
+                        double wait_start = MPI_Wtime();
+                        MPI_Wait(&recv_requests[next_chunk], MPI_STATUS_IGNORE);
+                        communication_wait_sum += MPI_Wtime() - wait_start;
+                        next_chunk++;
+                        partner_available = (next_chunk * chunk_elements < partner_size)
+                                            ? next_chunk * chunk_elements : partner_size;
+                    }
+                    if (partner_idx < partner_size &&
+                        (own_idx >= local_segment_size || partner_block[partner_idx] < current_block[own_idx])) {
+                        merge_buffer[out_idx] = partner_block[partner_idx++];
+                        block_changed = 1;
+                    } else {
+                        merge_buffer[out_idx] = current_block[own_idx++];
+                    }
+                }
+                moved_elements = partner_idx;
+            } else {
+                // Consome os pedaços do vizinho em ordem decrescente
+                int own_idx = local_segment_size - 1, partner_idx = partner_size - 1;
+                int partner_available_from = partner_size, next_chunk = recv_chunk_count - 1;
+                for (int out_idx = local_segment_size - 1; out_idx >= 0; --out_idx) {
+                    if (partner_idx >= 0 && partner_idx < partner_available_from) {
+                        double wait_start = MPI_Wtime();
+                        MPI_Wait(&recv_requests[next_chunk], MPI_STATUS_IGNORE);
+                        communication_wait_sum += MPI_Wtime() - wait_start;
+                        partner_available_from = next_chunk * chunk_elements;
+                        next_chunk--;
+                    }
+                    if (partner_idx >= 0 && (own_idx < 0 || partner_block[partner_idx] > current_block[own_idx])) {
+                        merge_buffer[out_idx] = partner_block[partner_idx--];
+                        block_changed = 1;
+                    } else {
+                        merge_buffer[out_idx] = current_block[own_idx--];
+                    }
+                }
+                moved_elements = partner_size - 1 - partner_idx;
+            }
+
+            // Pedaços não consumidos e envios precisam terminar antes de reutilizar os buffers
+            double merge_wait = communication_wait_sum - wait_before_merge; // Esperas por pedaços no merge
+            double trace_wait_start = tracing ? trace_now_us() : 0.0;
+            double wait_start = MPI_Wtime();
+            MPI_Waitall(recv_chunk_count, recv_requests, MPI_STATUSES_IGNORE);
+            MPI_Waitall(send_chunk_count, send_requests, MPI_STATUSES_IGNORE);
+            communication_wait_sum += MPI_Wtime() - wait_start;
+            if (tracing) {
+                // As esperas por pedaços durante o merge entram como espera dentro do evento de merge
+                trace_record(0, TRACE_MERGE, sort_iteration, trace_merge_start, trace_wait_start, merge_wait * 1e6,
+                             local_segment_size, moved_elements, 0);
+                trace_record(0, TRACE_EXCHANGE, sort_iteration, trace_wait_start, trace_now_us(), 0.0, 0, 0,
+                             (long long)local_segment_size * (long long)sizeof(int));
+            }
+
+            if (block_changed) {
+                int *previous_block = current_block;
+                current_block = merge_buffer;
+                merge_buffer = previous_block;
+                window_changed = 1;
+            }
+        }
+
+        // Ao fim de cada janela: consulta o teste da janela anterior e dispara o desta
+        if ((sort_iteration + 1) % check_interval == 0 && sort_iteration + 1 < phase_limit) {
+            if (convergence_request != MPI_REQUEST_NULL) {
+                double wait_start = MPI_Wtime();
+                double trace_wait_start = tracing ? trace_now_us() : 0.0;
+                MPI_Wait(&convergence_request, MPI_STATUS_IGNORE);
+                communication_wait_sum += MPI_Wtime() - wait_start;
+                if (tracing) trace_record(0, TRACE_REDUCE, sort_iteration, trace_wait_start, trace_now_us(), 0.0, 0, 0, 0);
+                if (!global_window_changed) {
+                    break; // Uma janela inteira (fases pares e ímpares) sem trocas: array já ordenado
+                }
+            }
+            pending_window_changed = window_changed;
+            window_changed = 0;
+            MPI_Iallreduce(&pending_window_changed, &global_window_changed, 1, MPI_INT, MPI_LOR,
+                           MPI_COMM_WORLD, &convergence_request);
+        }
+    }
+    if (convergence_request != MPI_REQUEST_NULL) {
+        MPI_Wait(&convergence_request, MPI_STATUS_IGNORE);
+    }
+
+    if (current_block != local_array_segment) {
+        memcpy(local_array_segment, current_block, local_segment_size * sizeof(int));
+        merge_buffer = current_block;
+    }
+    free(partner_block);
+    free(merge_buffer);
+    free(recv_requests);
+    free(send_requests);
+
+    return communication_wait_sum;
+}
+
+
+// Modo 'compartilhado': área de cada processo na janela de memória compartilhada do nó. A primeira
+// linha de cache guarda o contador de fases concluídas; em seguida vêm os dois buffers do bloco.
+#define SHARED_FLAGS_BYTES 64
+
+// Quantas das fases [0, phases) tiveram vizinho para 'rank'. Cada uma troca o buffer corrente do
+// processo, então a paridade indica em qual dos dois buffers da janela está o bloco dele.
+int phases_with_partner(int rank, int total_processes, int phases) {
+    int partnered = 0;
+    for (int phase = 0; phase < phases; ++phase) {
+        int partner = (phase % 2 == rank % 2) ? rank + 1 : rank - 1;
+        partnered += (partner >= 0 && partner < total_processes);
+    }
+    return partnered;
+}
+
+// Espera o vizinho do mesmo nó concluir 'target' fases (leitura direta do contador na janela)
+void wait_for_neighbour_phase(MPI_Win shared_window, const int *neighbour_phases_done, int target) {
+    while (__atomic_load_n(neighbour_phases_done, __ATOMIC_ACQUIRE) < target) {
+        MPI_Win_sync(shared_window);
+        sched_yield(); // Importante quando há mais processos que núcleos
+    }
+    MPI_Win_sync(shared_window);
+}
+
+// Janela do modo 'compartilhado' vista por um processo, independente do tipo dos elementos: os dois
+// buffers do próprio bloco, o contador de fases e os buffers dos vizinhos do mesmo nó ([esquerda,
+// direita]; NULL se o vizinho está em outro nó) e um buffer privado para vizinhos em outros nós.
+typedef struct {
+    MPI_Comm node_comm;
+    MPI_Win window;
+    int *phases_done;
+    char *own_buffers[2];
+    const int *neighbour_phases_done[2];
+    const char *neighbour_buffers[2][2];
+    char *partner_block;
+} shared_block_window;
+
+// Coletiva: divide MPI_COMM_WORLD por nó (MPI_Comm_split_type com MPI_COMM_TYPE_SHARED), aloca a janela
+// com dois buffers de 'largest_block' elementos de 'element_size' bytes por processo e abre o acesso
+// passivo que dura toda a ordenação.
+void shared_window_open(shared_block_window *shared, int largest_block, size_t element_size,
+                        int total_processes, int current_rank) {
+    // Comunicador do nó e posição dos vizinhos (esquerda, direita) nele; MPI_UNDEFINED = outro nó
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, current_rank, MPI_INFO_NULL, &shared->node_comm);
+    MPI_Group world_group, node_group;
+    MPI_Comm_group(MPI_COMM_WORLD, &world_group);
+    MPI_Comm_group(shared->node_comm, &node_group);
+    int neighbour_node_ranks[2] = { MPI_UNDEFINED, MPI_UNDEFINED };
+    for (int side = 0; side < 2; ++side) {
+        int neighbour = (side == 0) ? current_rank - 1 : current_rank + 1;
+        if (neighbour >= 0 && neighbour < total_processes) {
+            MPI_Group_translate_ranks(world_group, 1, &neighbour, node_group, &neighbour_node_ranks[side]);
+        }
+    }
+    MPI_Group_free(&world_group);
+    MPI_Group_free(&node_group);
+
+    // Área própria na janela; 'alloc_shared_noncontig' permite que cada área fique no nó NUMA do dono
+    MPI_Aint buffer_bytes = (MPI_Aint)largest_block * (MPI_Aint)element_size;
+    MPI_Info window_info;
+    MPI_Info_create(&window_info);
+    MPI_Info_set(window_info, "alloc_shared_noncontig", "true");
+    char *window_base;
+    MPI_Win_allocate_shared(SHARED_FLAGS_BYTES + 2 * buffer_bytes, 1, window_info, shared->node_comm,
+                            &window_base, &shared->window);
+    MPI_Info_free(&window_info);
+    shared->phases_done = (int *)window_base;
+    shared->own_buffers[0] = window_base + SHARED_FLAGS_BYTES;
+    shared->own_buffers[1] = shared->own_buffers[0] + buffer_bytes;
+
+    // Endereços das áreas dos vizinhos do mesmo nó
+    for (int side = 0; side < 2; ++side) {
+        shared->neighbour_phases_done[side] = NULL;
+        shared->neighbour_buffers[side][0] = shared->neighbour_buffers[side][1] = NULL;
+        if (neighbour_node_ranks[side] == MPI_UNDEFINED) continue;
+        MPI_Aint neighbour_bytes;
+        int neighbour_disp_unit;
+        char *neighbour_base;
+        MPI_Win_shared_query(shared->window, neighbour_node_ranks[side], &neighbour_bytes, &neighbour_disp_unit,
+                             &neighbour_base);
+        shared->neighbour_phases_done[side] = (const int *)neighbour_base;
+        shared->neighbour_buffers[side][0] = neighbour_base + SHARED_FLAGS_BYTES;
+        shared->neighbour_buffers[side][1] = shared->neighbour_buffers[side][0] + buffer_bytes;
+    }
+    // Buffer privado apenas para vizinhos em outros nós
+    shared->partner_block = NULL;
+    if ((current_rank > 0 && neighbour_node_ranks[0] == MPI_UNDEFINED) ||
+        (current_rank < total_processes - 1 && neighbour_node_ranks[1] == MPI_UNDEFINED)) {
+        shared->partner_block = (char *)malloc((size_t)buffer_bytes);
+        if (shared->partner_block == NULL) {
+            fprintf(stderr, "Erro: Falha na alocação do buffer de troca no rank %d.\n", current_rank);
+            MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+        }
+    }
+
+    // Acesso passivo à janela durante toda a ordenação; a ordem entre processos vem dos contadores
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, shared->window);
+    __atomic_store_n(shared->phases_done, 0, __ATOMIC_RELEASE);
+}
+
+// Coletiva no nó: torna visíveis os blocos iniciais (já ordenados em own_buffers[0]) e os contadores
+void shared_window_publish_blocks(const shared_block_window *shared) {
+    MPI_Win_sync(shared->window);
+    MPI_Barrier(shared->node_comm);
+    MPI_Win_sync(shared->window);
+}
+
+// Os dois vizinhos do nó precisam ter concluído a fase anterior a 'phase': o parceiro desta fase
+// publicou seu bloco e o da fase anterior terminou de ler o buffer que será sobrescrito agora
+void shared_window_wait_phase(const shared_block_window *shared, int phase) {
+    for (int side = 0; side < 2; ++side) {
+        if (shared->neighbour_phases_done[side] != NULL) {
+            wait_for_neighbour_phase(shared->window, shared->neighbour_phases_done[side], phase);
+        }
+    }
+}
+
+// Bloco corrente do vizinho 'partner_rank' no início da fase 'phase', ou NULL se ele está em outro nó
+const char *shared_window_partner_data(const shared_block_window *shared, int partner_rank, int total_processes,
+                                       int current_rank, int phase) {
+    int side = (partner_rank > current_rank) ? 1 : 0;
+    if (shared->neighbour_phases_done[side] == NULL) return NULL;
+    return shared->neighbour_buffers[side][phases_with_partner(partner_rank, total_processes, phase) % 2];
+}
+
+// Publica a conclusão de 'phases_completed' fases (também nas fases em que o processo da borda fica ocioso)
+void shared_window_publish_phase(const shared_block_window *shared, int phases_completed) {
+    MPI_Win_sync(shared->window);
+    __atomic_store_n(shared->phases_done, phases_completed, __ATOMIC_RELEASE);
+}
+
+// Coletiva no nó: ninguém libera a janela enquanto um vizinho ainda pode lê-la
+void shared_window_close(shared_block_window *shared) {
+    MPI_Win_unlock_all(shared->window);
+    MPI_Win_free(&shared->window);
+    MPI_Comm_free(&shared->node_comm);
+    free(shared->partner_block);
+}
+
+// Odd-Even Transposition Sort por blocos (compare-split) utilizando MPI, gerado para cada elemento
+// (modo 'bloco'). Cada fase troca o bloco local INTEIRO com o vizinho; o processo da esquerda mantém os
+// menores elementos da intercalação e o da direita os maiores, cada um preservando o tamanho do seu
+// bloco. Com blocos de mesmo tamanho, 'total_processes' fases bastam; com tamanhos diferentes (divisão
+// não exata ou particionamento ponderado) seguem-se pares de fases até o teste de convergência passar.
+//
+// parallel_odd_even_sort_mpi_shared_<tipo> (modo 'compartilhado'): as mesmas fases com troca sem cópia
+// entre processos do mesmo nó. Cada processo mantém seu bloco em dois buffers da janela compartilhada
+// (shared_window_open). Quando o vizinho da fase está no mesmo nó, o merge-split lê o bloco dele
+// diretamente da janela e grava no outro buffer local, em vez de copiar o bloco com MPI_Sendrecv para um
+// buffer privado e lê-lo de novo: cerca de metade do tráfego de memória por troca. A sincronização usa
+// só o contador de fases de cada processo: antes da fase p, cada processo espera os vizinhos do nó
+// concluírem a fase p-1 (dados prontos e leituras do seu buffer encerradas). Vizinhos em outros nós
+// continuam trocando mensagens.
+//
+// Ambos retornam o tempo de espera e comunicação deste processo.
+#define DEFINE_BLOCK_ENGINES(suffix, element_type)                                                     \
+double parallel_odd_even_sort_mpi_blocks_##suffix(element_type local_block[], const int block_counts[], \
+                                                  int total_processes, int current_rank,               \
+                                                  MPI_Datatype element_datatype) {                     \
+    double communication_duration_sum = 0.0;                                                           \
+    int local_segment_size = block_counts[current_rank];                                               \
+    int largest_block = 0;                                                                             \
+    for (int rank = 0; rank < total_processes; ++rank) {                                               \
+        if (block_counts[rank] > largest_block) largest_block = block_counts[rank];                    \
+    }                                                                                                  \
+    bool uniform_blocks = partition_is_uniform(block_counts, total_processes);                         \
+                                                                                                       \
+    /* Buffers auxiliares: bloco recebido do vizinho e resultado da intercalação */                    \
+    element_type *partner_block = (element_type *)malloc(largest_block * sizeof(element_type));        \
+    element_type *merge_buffer = (element_type *)malloc(largest_block * sizeof(element_type));         \
+    if (partner_block == NULL || merge_buffer == NULL) {                                               \
+        fprintf(stderr, "Erro: Falha na alocação dos buffers de troca no rank %d.\n", current_rank);   \
+        MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);                                                       \
+    }                                                                                                  \
+    element_type *current_block = local_block; /* Alterna com merge_buffer para evitar cópias */       \
+    int tracing = trace_enabled();                                                                     \
+    traced_local_sort_##suffix(current_block, local_segment_size, merge_buffer);                       \
+                                                                                                       \
+    int phase_limit = total_processes;                                                                 \
+    for (int sort_iteration = 0; ; ++sort_iteration) {                                                 \
+        if (sort_iteration >= phase_limit) {                                                           \
+            if (uniform_blocks ||                                                                      \
+                blocks_globally_ordered_##suffix(current_block, local_segment_size, total_processes, current_rank, \
+                                                 element_datatype, &communication_duration_sum)) {     \
+                break;                                                                                 \
+            }                                                                                          \
+            phase_limit += 2; /* Mais uma fase par e uma ímpar */                                      \
+        }                                                                                              \
+        /* Fase par: pares (0,1), (2,3)...; fase ímpar: pares (1,2), (3,4)... */                       \
+        int partner_rank = (sort_iteration % 2 == current_rank % 2) ? current_rank + 1 : current_rank - 1; \
+        if (partner_rank < 0 || partner_rank >= total_processes) {                                     \
+            continue; /* Processo da borda fica ocioso nesta fase */                                   \
+        }                                                                                              \
+        int partner_size = block_counts[partner_rank];                                                 \
+                                                                                                       \
+        double comm_start_time = MPI_Wtime();                                                          \
+        double trace_exchange_start = tracing ? trace_now_us() : 0.0;                                  \
+        MPI_Sendrecv(current_block, local_segment_size, element_datatype, partner_rank, 0,             \
+                     partner_block, partner_size, element_datatype, partner_rank, 0,                   \
+                     MPI_COMM_WORLD, MPI_STATUS_IGNORE);                                               \
+        communication_duration_sum += MPI_Wtime() - comm_start_time;                                   \
+        double trace_merge_start = tracing ? trace_now_us() : 0.0;                                     \
+        long moved_elements = merge_split_with_partner_##suffix(current_block, local_segment_size, partner_block, \
+                                                                partner_size, merge_buffer,            \
+                                                                current_rank < partner_rank, tracing); \
+        if (tracing) {                                                                                 \
+            trace_record(0, TRACE_EXCHANGE, sort_iteration, trace_exchange_start, trace_merge_start, 0.0, 0, 0, \
+                         (long long)local_segment_size * (long long)sizeof(element_type));             \
+            trace_record(0, TRACE_MERGE, sort_iteration, trace_merge_start, trace_now_us(), 0.0,       \
+                         local_segment_size, moved_elements, 0);                                       \
+        }                                                                                              \
+        /* O resultado da intercalação passa a ser o bloco corrente */                                 \
+        element_type *previous_block = current_block;                                                  \
+        current_block = merge_buffer;                                                                  \
+        merge_buffer = previous_block;                                                                 \
+    }                                                                                                  \
+                                                                                                       \
+    /* Garante que o resultado final esteja no array do chamador */                                    \
+    if (current_block != local_block) {                                                                \
+        memcpy(local_block, current_block, local_segment_size * sizeof(element_type));                 \
+        merge_buffer = current_block;                                                                  \
+    }                                                                                                  \
+    free(partner_block);                                                                               \
+    free(merge_buffer);                                                                                \
+    return communication_duration_sum;                                                                 \
+}                                                                                                      \
+                                                                                                       \
+double parallel_odd_even_sort_mpi_shared_##suffix(element_type local_block[], const int block_counts[], \
+                                                  int total_processes, int current_rank,               \
+                                                  MPI_Datatype element_datatype) {                     \
+    double communication_duration_sum = 0.0;                                                           \
+    int local_segment_size = block_counts[current_rank];                                               \
+    int largest_block = 0;                                                                             \
+    for (int rank = 0; rank < total_processes; ++rank) {                                               \
+        if (block_counts[rank] > largest_block) largest_block = block_counts[rank];                    \
+    }                                                                                                  \
+    bool uniform_blocks = partition_is_uniform(block_counts, total_processes);                         \
+    int tracing = trace_enabled();                                                                     \
+                                                                                                       \
+    shared_block_window shared;                                                                        \
+    shared_window_open(&shared, largest_block, sizeof(element_type), total_processes, current_rank);   \
+    element_type *own_buffers[2] = { (element_type *)shared.own_buffers[0],                            \
+                                     (element_type *)shared.own_buffers[1] };                          \
+    int current = 0; /* Buffer com o bloco corrente */                                                 \
+    memcpy(own_buffers[current], local_block, local_segment_size * sizeof(element_type));              \
+    traced_local_sort_##suffix(own_buffers[current], local_segment_size, own_buffers[1 - current]);    \
+    shared_window_publish_blocks(&shared);                                                             \
+                                                                                                       \
+    int phase_limit = total_processes;                                                                 \
+    for (int sort_iteration = 0; ; ++sort_iteration) {                                                 \
+        if (sort_iteration >= phase_limit) {                                                           \
+            if (uniform_blocks ||                                                                      \
+                blocks_globally_ordered_##suffix(own_buffers[current], local_segment_size, total_processes, \
+                                                 current_rank, element_datatype, &communication_duration_sum)) { \
+                break;                                                                                 \
+            }                                                                                          \
+            phase_limit += 2; /* Mais uma fase par e uma ímpar */                                      \
+        }                                                                                              \
+                                                                                                       \
+        int partner_rank = (sort_iteration % 2 == current_rank % 2) ? current_rank + 1 : current_rank - 1; \
+        if (partner_rank >= 0 && partner_rank < total_processes) {                                     \
+            int partner_size = block_counts[partner_rank];                                             \
+            double comm_start_time = MPI_Wtime();                                                      \
+            double trace_exchange_start = tracing ? trace_now_us() : 0.0;                              \
+            shared_window_wait_phase(&shared, sort_iteration);                                         \
+            const element_type *partner_data = (const element_type *)shared_window_partner_data(       \
+                &shared, partner_rank, total_processes, current_rank, sort_iteration);                 \
+            long long exchanged_bytes = 0;                                                             \
+            if (partner_data == NULL) {                                                                \
+                MPI_Sendrecv(own_buffers[current], local_segment_size, element_datatype, partner_rank, 0, \
+                             shared.partner_block, partner_size, element_datatype, partner_rank, 0,    \
+                             MPI_COMM_WORLD, MPI_STATUS_IGNORE);                                       \
+                partner_data = (const element_type *)shared.partner_block;                             \
+                exchanged_bytes = (long long)local_segment_size * (long long)sizeof(element_type);     \
+            }                                                                                          \
+            communication_duration_sum += MPI_Wtime() - comm_start_time;                               \
+            double trace_merge_start = tracing ? trace_now_us() : 0.0;                                 \
+            long moved_elements = merge_split_with_partner_##suffix(own_buffers[current], local_segment_size, \
+                                                                    partner_data, partner_size,        \
+                                                                    own_buffers[1 - current],          \
+                                                                    current_rank < partner_rank, tracing); \
+            current = 1 - current;                                                                     \
+            if (tracing) {                                                                             \
+                trace_record(0, TRACE_EXCHANGE, sort_iteration, trace_exchange_start, trace_merge_start, 0.0, 0, \
+                             0, exchanged_bytes);                                                      \
+                trace_record(0, TRACE_MERGE, sort_iteration, trace_merge_start, trace_now_us(), 0.0,   \
+                             local_segment_size, moved_elements, 0);                                   \
+            }                                                                                          \
+        }                                                                                              \
+        shared_window_publish_phase(&shared, sort_iteration + 1);                                      \
+    }                                                                                                  \
+                                                                                                       \
+    memcpy(local_block, own_buffers[current], local_segment_size * sizeof(element_type));              \
+    shared_window_close(&shared);                                                                      \
+    return communication_duration_sum;                                                                 \
+}
+
+#define DEFINE_BLOCK_ENGINES_FOR_KEY(name, type)                                                       \
+    DEFINE_BLOCK_ENGINES(name, type)                                                                   \
+    DEFINE_BLOCK_ENGINES(record_##name, record_##name)
+
+ODD_EVEN_KEY_TYPES(DEFINE_BLOCK_ENGINES_FOR_KEY)
+
+// Tipo MPI de cada chave, escolhido em tempo de compilação
+#define KEY_MPI_DATATYPE(key) _Generic((key),                                                          \
+    int: MPI_INT, int64_t: MPI_INT64_T, uint32_t: MPI_UINT32_T, float: MPI_FLOAT, double: MPI_DOUBLE)
+
+// Tipos MPI dos elementos: a própria chave ou um tipo derivado { chave, payload } com a extensão da
+// struct C (inclui o preenchimento), para que contagens de elementos funcionem em Scatterv/Sendrecv.
+// Retorna 1 se o tipo foi criado e deve ser liberado com MPI_Type_free.
+#define DEFINE_MPI_ELEMENT_DATATYPES(name, type)                                                       \
+int element_datatype_##name(MPI_Datatype *datatype) {                                                  \
+    *datatype = KEY_MPI_DATATYPE((type)0);                                                             \
+    return 0;                                                                                          \
+}                                                                                                      \
+                                                                                                       \
+int element_datatype_record_##name(MPI_Datatype *datatype) {                                           \
+    int block_lengths[2] = { 1, 1 };                                                                   \
+    MPI_Aint displacements[2] = { offsetof(record_##name, key), offsetof(record_##name, payload) };   \
+    MPI_Datatype field_types[2] = { KEY_MPI_DATATYPE((type)0), MPI_INT64_T };                          \
+    MPI_Datatype packed_record;                                                                        \
+    MPI_Type_create_struct(2, block_lengths, displacements, field_types, &packed_record);               \
+    MPI_Type_create_resized(packed_record, 0, sizeof(record_##name), datatype);                        \
+    MPI_Type_free(&packed_record);                                                                     \
+    MPI_Type_commit(datatype);                                                                         \
+    return 1;                                                                                          \
+}
+
+ODD_EVEN_KEY_TYPES(DEFINE_MPI_ELEMENT_DATATYPES)
+
+// Execução dos modos 'bloco' e 'compartilhado' para os demais tipos (ODD_EVEN_KEY / ODD_EVEN_PAYLOAD):
+// run_typed_mpi_<tipo> gera a entrada, ordena com parallel_odd_even_sort_mpi_blocks_<tipo> ou
+// parallel_odd_even_sort_mpi_shared_<tipo> (os mesmos motores dos caminhos int), reúne e verifica.
+//
+// distributed_verify_<tipo> é a verificação distribuída da saída (usada também pelos caminhos int):
+// cada processo confere a ordem do próprio bloco (em paralelo na versão híbrida) e a fronteira com o
+// vizinho da direita por uma única troca; os pares fora de ordem e as assinaturas de multiconjunto
+// da entrada e da saída são somados em um único MPI_Allreduce. Nenhum processo precisa do array
+// completo. Coletiva; retorna se a saída está em ordem e grava em 'is_permutation' se ela é uma
+// permutação da entrada ('input_checksum' é a assinatura do bloco local antes da ordenação).
+#define DEFINE_TYPED_MPI_RUN(suffix, element_type)                                                     \
+bool distributed_verify_##suffix(const element_type block[], int block_size, const uint64_t input_checksum[], \
+                                 int total_processes, int current_rank, MPI_Datatype element_datatype, \
+                                 bool *is_permutation) {                                               \
+    int left_partner = (current_rank > 0) ? current_rank - 1 : MPI_PROC_NULL;                          \
+    int right_partner = (current_rank < total_processes - 1) ? current_rank + 1 : MPI_PROC_NULL;       \
+    element_type right_first = block[block_size - 1];                                                  \
+    MPI_Sendrecv(&block[0], 1, element_datatype, left_partner, 2,                                      \
+                 &right_first, 1, element_datatype, right_partner, 2, MPI_COMM_WORLD, MPI_STATUS_IGNORE); \
+    /* [pares fora de ordem, assinatura da entrada, assinatura da saída] */                            \
+    uint64_t local_terms[1 + 2 * MULTISET_CHECKSUM_WORDS], global_terms[1 + 2 * MULTISET_CHECKSUM_WORDS]; \
+    local_terms[0] = !verify_sorted_##suffix(block, block_size) ||                                     \
+                     element_key_##suffix(&right_first) < element_key_##suffix(&block[block_size - 1]); \
+    memcpy(local_terms + 1, input_checksum, MULTISET_CHECKSUM_WORDS * sizeof(uint64_t));              \
+    multiset_checksum_clear(local_terms + 1 + MULTISET_CHECKSUM_WORDS);                                \
+    multiset_checksum_##suffix(block, block_size, local_terms + 1 + MULTISET_CHECKSUM_WORDS);          \
+    MPI_Allreduce(local_terms, global_terms, 1 + 2 * MULTISET_CHECKSUM_WORDS, MPI_UINT64_T, MPI_SUM,   \
+                  MPI_COMM_WORLD);                                                                     \
+    *is_permutation = multiset_checksums_equal(global_terms + 1, global_terms + 1 + MULTISET_CHECKSUM_WORDS); \
+    return global_terms[0] == 0;                                                                       \
+}                                                                                                      \
+                                                                                                       \
+int run_typed_mpi_##suffix(int overall_array_size, const int block_counts[], const int block_displs[], \
+                           int total_processes, int current_rank, const input_config *input_settings,  \
+                           const char *exchange_mode, const char *type_text) {                         \
+    MPI_Datatype element_datatype;                                                                     \
+    int free_datatype = element_datatype_##suffix(&element_datatype);                                  \
+    int local_data_size = block_counts[current_rank];                                                  \
+    element_type *local_block = (element_type *)malloc(local_data_size * sizeof(element_type));       \
+    element_type *full_array = NULL;                                                                   \
+    if (current_rank == 0) {                                                                           \
+        full_array = (element_type *)malloc((size_t)overall_array_size * sizeof(element_type));        \
+    }                                                                                                  \
+    if (local_block == NULL || (current_rank == 0 && full_array == NULL)) {                            \
+        fprintf(stderr, "Erro: Falha na alocação de memória no rank %d.\n", current_rank);             \
+        MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);                                                       \
+    }                                                                                                  \
+    /* Cada rank gera a própria fatia (gerador por contador), sem Scatterv */                          \
+    fill_range_##suffix(local_block, block_displs[current_rank], local_data_size,                      \
+                        overall_array_size, input_settings);                                           \
+    uint64_t input_checksum[MULTISET_CHECKSUM_WORDS];                                                  \
+    multiset_checksum_clear(input_checksum);                                                           \
+    multiset_checksum_##suffix(local_block, local_data_size, input_checksum);                          \
+    if (current_rank == 0) {                                                                           \
+        report_input_config(input_settings, stderr);                                                   \
+        fprintf(stderr, "Array inicial (segmento no Rank 0): ");                                      \
+        display_segment_##suffix(local_block, local_data_size, stderr);                                \
+    }                                                                                                  \
+                                                                                                       \
+    double start_wall_time = MPI_Wtime();                                                              \
+    double local_comm_time = (strcmp(exchange_mode, "compartilhado") == 0)                             \
+        ? parallel_odd_even_sort_mpi_shared_##suffix(local_block, block_counts, total_processes, current_rank, \
+                                                  element_datatype)                                    \
+        : parallel_odd_even_sort_mpi_blocks_##suffix(local_block, block_counts, total_processes, current_rank, \
+                                                  element_datatype);                                   \
+    MPI_Gatherv(local_block, local_data_size, element_datatype,                                        \
+                full_array, block_counts, block_displs, element_datatype, 0, MPI_COMM_WORLD);          \
+    MPI_Barrier(MPI_COMM_WORLD);                                                                       \
+    double total_execution_time = MPI_Wtime() - start_wall_time;                                       \
+                                                                                                       \
+    double summed_comm_time_all_procs, max_total_time_across_procs;                                    \
+    MPI_Reduce(&local_comm_time, &summed_comm_time_all_procs, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD); \
+    MPI_Reduce(&total_execution_time, &max_total_time_across_procs, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD); \
+    double verify_start = MPI_Wtime();                                                                 \
+    bool is_permutation;                                                                               \
+    bool in_order = distributed_verify_##suffix(local_block, local_data_size, input_checksum,           \
+                                                total_processes, current_rank, element_datatype,       \
+                                                &is_permutation);                                      \
+    double verify_time = MPI_Wtime() - verify_start;                                                   \
+    if (current_rank == 0) {                                                                           \
+        fprintf(stdout, "\n--- Resultados da Execução MPI ---\n");                                    \
+        fprintf(stdout, "Tamanho do Array: %d\n", overall_array_size);                                 \
+        fprintf(stdout, "Número de Processos MPI: %d\n", total_processes);                            \
+        fprintf(stdout, "Modo de Troca: %s\n", exchange_mode);                                         \
+        fprintf(stdout, "Tipo dos Elementos: %s\n", type_text);                                        \
+        fprintf(stdout, "Tempo de Execução Total (Máximo entre processos): %.6f segundos\n", max_total_time_across_procs); \
+        fprintf(stdout, "Tempo de Comunicação Total (Soma entre processos): %.6f segundos\n", summed_comm_time_all_procs); \
+        report_verification(stdout, in_order, is_permutation, verify_time);                            \
+        fprintf(stdout, "O array final está ordenado: %s\n", (in_order && is_permutation) ? "Sim" : "Não"); \
+        fprintf(stderr, "Array Final (segmento no Rank 0): ");                                         \
+        display_segment_##suffix(full_array, overall_array_size, stderr);                              \
+    }                                                                                                  \
+    free(full_array);                                                                                  \
+    free(local_block);                                                                                 \
+    if (free_datatype) MPI_Type_free(&element_datatype);                                               \
+    return (in_order && is_permutation) ? EXIT_SUCCESS : EXIT_FAILURE;                                 \
+}
+
+#define DEFINE_TYPED_MPI_RUNS(name, type)                                                              \
+    DEFINE_TYPED_MPI_RUN(name, type)                                                                   \
+    DEFINE_TYPED_MPI_RUN(record_##name, record_##name)
+
+ODD_EVEN_KEY_TYPES(DEFINE_TYPED_MPI_RUNS)
+
+// Despacha para a versão especializada do tipo configurado. Coletiva.
+int run_typed_mpi(const key_config *key_settings, int overall_array_size, const int block_counts[],
+                  const int block_displs[], int total_processes, int current_rank,
+                  const input_config *input_settings, const char *exchange_mode) {
+    char type_text[32];
+    describe_key_config(key_settings, type_text, sizeof(type_text));
+    switch (key_settings->type) {
+#define TYPED_MPI_CASE(name, type)                                                                     \
+    case KEY_TYPE_##name:                                                                              \
+        return key_settings->with_payload                                                              \
+                   ? run_typed_mpi_record_##name(overall_array_size, block_counts, block_displs,       \
+                                                 total_processes, current_rank, input_settings,        \
+                                                 exchange_mode, type_text)                             \
+                   : run_typed_mpi_##name(overall_array_size, block_counts, block_displs,              \
+                                          total_processes, current_rank, input_settings,               \
+                                          exchange_mode, type_text);
+        ODD_EVEN_KEY_TYPES(TYPED_MPI_CASE)
+#undef TYPED_MPI_CASE
+    default:
+        return EXIT_FAILURE;
+    }
+}
+
+// Executa o modo de troca escolhido sobre os blocos locais já distribuídos.
+// Retorna o tempo de comunicação (ou de espera, no modo sobreposto) deste processo.
+double run_selected_sort(const char *exchange_mode, int local_array_segment[], int total_global_elements,
+                         const int block_counts[], int total_processes, int current_rank,
+                         int chunk_elements, int check_interval) {
+    if (strcmp(exchange_mode, "sobreposto") == 0) {
+        return parallel_odd_even_sort_mpi_overlapped(local_array_segment, block_counts, total_processes,
+                                                     current_rank, chunk_elements, check_interval);
+    }
+    if (strcmp(exchange_mode, "compartilhado") == 0) {
+        return parallel_odd_even_sort_mpi_shared_int(local_array_segment, block_counts, total_processes,
+                                                     current_rank, MPI_INT);
+    }
+    if (strcmp(exchange_mode, "bloco") == 0) {
+        return parallel_odd_even_sort_mpi_blocks_int(local_array_segment, block_counts, total_processes,
+                                                     current_rank, MPI_INT);
+    }
+    return parallel_odd_even_sort_mpi(local_array_segment, total_global_elements, block_counts,
+                                      total_processes, current_rank);
+}
+
+// Calcula o particionamento ('uniforme' ou 'calibrada'; ver ODD_EVEN_PARTITION em main)
+void build_partition(const char *partition_mode, int total_elements, int total_processes,
+                     int block_counts[], int block_displs[]) {
+    if (strcmp(partition_mode, "calibrada") == 0) {
+        double *rank_weights = (double *)malloc(total_processes * sizeof(double));
+        if (rank_weights == NULL) {
+            fprintf(stderr, "Erro: Falha na alocação dos pesos do particionamento.\n");
+            MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+        }
+        double local_speed = calibrate_local_sort_speed();
+        MPI_Allgather(&local_speed, 1, MPI_DOUBLE, rank_weights, 1, MPI_DOUBLE, MPI_COMM_WORLD);
+        compute_block_partition(total_elements, total_processes, rank_weights, block_counts, block_displs);
+        free(rank_weights);
+    } else {
+        compute_block_partition(total_elements, total_processes, NULL, block_counts, block_displs);
+    }
+}
+
+// No modo 'sobreposto' a tag de cada mensagem é o índice do pedaço, e o MPI só garante tags até
+// MPI_TAG_UB (no mínimo 32767). Retorna o tamanho de pedaço a usar: o pedido, ou o menor que mantém
+// o maior índice de pedaço dentro do limite (com aviso no rank 0). Também limita os vetores de
+// requisições por pedaço.
+int chunk_elements_within_tag_limit(const int block_counts[], int total_processes, int chunk_elements,
+                                    int current_rank) {
+    int *tag_upper_bound, attribute_found;
+    MPI_Comm_get_attr(MPI_COMM_WORLD, MPI_TAG_UB, &tag_upper_bound, &attribute_found);
+    long max_chunk_count = attribute_found ? (long)*tag_upper_bound + 1 : 32768;
+    int largest_block = 0;
+    for (int rank = 0; rank < total_processes; ++rank) {
+        if (block_counts[rank] > largest_block) largest_block = block_counts[rank];
+    }
+    if ((largest_block + (long)chunk_elements - 1) / chunk_elements <= max_chunk_count) {
+        return chunk_elements;
+    }
+    int fitted = (int)((largest_block + max_chunk_count - 1) / max_chunk_count);
+    if (current_rank == 0) {
+        fprintf(stderr, "Aviso: %d elementos por pedaço excedem MPI_TAG_UB (%ld pedaços por bloco); usando %d.\n",
+                chunk_elements, max_chunk_count, fitted);
+    }
+    return fitted;
+}
+
+// Instrumentação (ODD_EVEN_TRACE / ODD_EVEN_PERF): reúne no rank 0 o resumo e os eventos de cada
+// processo, grava um único trace (um "processo" Chrome por rank) e imprime a tabela por rank.
+// Coletiva: todos os processos devem chamar.
+void finish_trace_mpi(int total_processes, int current_rank) {
+    if (!trace_enabled()) {
+        return;
+    }
+    trace_summary local_summary = odd_even_trace.tracks[0].summary;
+    trace_summary *all_summaries = NULL;
+    int *rank_ids = NULL, *track_ids = NULL;
+    if (current_rank == 0) {
+        all_summaries = (trace_summary *)malloc(total_processes * sizeof(trace_summary));
+        rank_ids = (int *)malloc(total_processes * sizeof(int));
+        track_ids = (int *)calloc(total_processes, sizeof(int));
+        if (all_summaries == NULL || rank_ids == NULL || track_ids == NULL) {
+            fprintf(stderr, "Erro: Falha na alocação do resumo da instrumentação.\n");
+            MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+        }
+        for (int rank = 0; rank < total_processes; ++rank) rank_ids[rank] = rank;
+    }
+    MPI_Gather(&local_summary, (int)sizeof(trace_summary), MPI_BYTE,
+               all_summaries, (int)sizeof(trace_summary), MPI_BYTE, 0, MPI_COMM_WORLD);
+
+    if (odd_even_trace.output_path != NULL) {
+        size_t event_count;
+        trace_event *local_events = trace_collect_events(&event_count);
+        int local_bytes = (int)(event_count * sizeof(trace_event));
+        int *byte_counts = NULL, *byte_displs = NULL;
+        char *gathered_events = NULL;
+        long long total_bytes = 0;
+        if (current_rank == 0) {
+            byte_counts = (int *)malloc(total_processes * sizeof(int));
+            byte_displs = (int *)malloc(total_processes * sizeof(int));
+        }
+        MPI_Gather(&local_bytes, 1, MPI_INT, byte_counts, 1, MPI_INT, 0, MPI_COMM_WORLD);
+        if (current_rank == 0) {
+            for (int rank = 0; rank < total_processes; ++rank) {
+                byte_displs[rank] = (int)total_bytes;
+                total_bytes += byte_counts[rank];
+            }
+            gathered_events = (char *)malloc(total_bytes > 0 ? (size_t)total_bytes : 1);
+            if (gathered_events == NULL) {
+                fprintf(stderr, "Erro: Falha na alocação dos eventos da instrumentação.\n");
+                MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+            }
+        }
+        MPI_Gatherv(local_events, local_bytes, MPI_BYTE, gathered_events, byte_counts, byte_displs, MPI_BYTE,
+                    0, MPI_COMM_WORLD);
+        if (current_rank == 0) {
+            size_t total_events = (size_t)total_bytes / sizeof(trace_event);
+            if (trace_write_chrome_json(odd_even_trace.output_path, (const trace_event *)gathered_events,
+                                        total_events, "odd_even_mpi", "rank", total_processes,
+                                        all_summaries, rank_ids, track_ids, total_processes)) {
+                fprintf(stderr, "Trace gravado em %s (%zu eventos)\n", odd_even_trace.output_path, total_events);
+            }
+        }
+        free(gathered_events);
+        free(byte_counts);
+        free(byte_displs);
+        free(local_events);
+    }
+
+    if (current_rank == 0) {
+        trace_print_summary(stderr, "rank", all_summaries, rank_ids, total_processes);
+    }
+    free(all_summaries);
+    free(rank_ids);
+    free(track_ids);
+    trace_release();
+}
+
+// Modo arquivo (MPI-IO): abre o arquivo de entrada e confere que ele contém de 'total_processes' a
+// INT32_MAX chaves de 'key_size' bytes ('key_text' nomeia o tipo na mensagem de erro). Coletiva;
+// retorna 0 (arquivo já fechado) em caso de erro.
+int open_binary_key_file(const char *input_path, size_t key_size, const char *key_text, int total_processes,
+                         int current_rank, MPI_File *input_file, MPI_Offset *file_bytes, int *key_count) {
+    if (MPI_File_open(MPI_COMM_WORLD, input_path, MPI_MODE_RDONLY, MPI_INFO_NULL, input_file) != MPI_SUCCESS) {
+        if (current_rank == 0) fprintf(stderr, "Erro: não foi possível abrir '%s'.\n", input_path);
+        return 0;
+    }
+    MPI_File_get_size(*input_file, file_bytes);
+    MPI_Offset keys_in_file = *file_bytes / (MPI_Offset)key_size;
+    if (*file_bytes % (MPI_Offset)key_size != 0 || keys_in_file > INT32_MAX || keys_in_file < total_processes) {
+        if (current_rank == 0) {
+            fprintf(stderr, "Erro: '%s' deve conter entre %d e %d chaves %s (tem %lld bytes).\n",
+                    input_path, total_processes, INT32_MAX, key_text, (long long)*file_bytes);
+        }
+        MPI_File_close(input_file);
+        return 0;
+    }
+    *key_count = (int)keys_in_file;
+    return 1;
+}
+
+// Lê 'local_data_size' chaves a partir de 'local_offset' e fecha o arquivo de entrada. Uma leitura que
+// falha ou termina antes do fim da fatia deixaria o bloco sem inicializar (e a assinatura da entrada
+// seria calculada sobre ele), então uma falha em qualquer processo reprova todos. Coletiva; retorna 1
+// se todas as fatias foram lidas por inteiro.
+int read_binary_key_file(const char *input_path, MPI_File *input_file, MPI_Offset local_offset,
+                         void *local_block, int local_data_size, MPI_Datatype key_datatype, int current_rank) {
+    MPI_Status read_status;
+    int keys_read = 0;
+    int local_read_failed = (MPI_File_read_at_all(*input_file, local_offset, local_block, local_data_size,
+                                                  key_datatype, &read_status) != MPI_SUCCESS);
+    if (!local_read_failed) {
+        MPI_Get_count(&read_status, key_datatype, &keys_read);
+        local_read_failed = (keys_read != local_data_size);
+    }
+    local_read_failed |= (MPI_File_close(input_file) != MPI_SUCCESS);
+    int read_failed;
+    MPI_Allreduce(&local_read_failed, &read_failed, 1, MPI_INT, MPI_LOR, MPI_COMM_WORLD);
+    if (read_failed && current_rank == 0) fprintf(stderr, "Erro: falha ao ler '%s'.\n", input_path);
+    return !read_failed;
+}
+
+// Grava o bloco local na posição 'local_offset' do arquivo de saída (com 'file_bytes' bytes). Os erros
+// de arquivo retornam (MPI_ERRORS_RETURN); uma falha em qualquer processo reprova todos. Coletiva;
+// retorna 1 se a gravação foi concluída.
+int write_binary_key_file(const char *output_path, MPI_Offset file_bytes, MPI_Offset local_offset,
+                          const void *local_block, int local_data_size, MPI_Datatype key_datatype,
+                          int current_rank) {
+    MPI_File output_file;
+    if (MPI_File_open(MPI_COMM_WORLD, output_path, MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL,
+                      &output_file) != MPI_SUCCESS) {
+        if (current_rank == 0) fprintf(stderr, "Erro: não foi possível criar '%s'.\n", output_path);
+        return 0;
+    }
+    int local_write_failed = (MPI_File_set_size(output_file, file_bytes) != MPI_SUCCESS);
+    local_write_failed |= (MPI_File_write_at_all(output_file, local_offset, local_block, local_data_size,
+                                                 key_datatype, MPI_STATUS_IGNORE) != MPI_SUCCESS);
+    local_write_failed |= (MPI_File_close(&output_file) != MPI_SUCCESS);
+    int write_failed;
+    MPI_Allreduce(&local_write_failed, &write_failed, 1, MPI_INT, MPI_LOR, MPI_COMM_WORLD);
+    if (write_failed && current_rank == 0) fprintf(stderr, "Erro: falha ao gravar '%s'.\n", output_path);
+    return !write_failed;
+}
+
+// Relatório do modo arquivo no rank 0; 'max_times' = { leitura, ordenação, escrita, comunicação,
+// verificação }, máximos entre os processos
+void report_file_results(const char *input_path, const char *output_path, int overall_array_size,
+                         int total_processes, const char *exchange_mode, const char *partition_mode,
+                         const char *key_text, const double max_times[5], bool in_order, bool is_permutation) {
+    fprintf(stdout, "\n--- Resultados da Execução MPI (arquivo) ---\n");
+    fprintf(stdout, "Arquivo de Entrada: %s\n", input_path);
+    fprintf(stdout, "Arquivo de Saída: %s\n", output_path);
+    fprintf(stdout, "Tamanho do Array: %d\n", overall_array_size);
+    fprintf(stdout, "Número de Processos MPI: %d\n", total_processes);
+    fprintf(stdout, "Modo de Troca: %s\n", exchange_mode);
+    fprintf(stdout, "Particionamento: %s\n", partition_mode);
+    fprintf(stdout, "Tipo dos Elementos: %s\n", key_text);
+    fprintf(stdout, "Tempo de Leitura (MPI-IO, máximo): %.6f segundos\n", max_times[0]);
+    fprintf(stdout, "Tempo de Execução Total (Máximo entre processos): %.6f segundos\n", max_times[1]);
+    fprintf(stdout, "Tempo de Escrita (MPI-IO, máximo): %.6f segundos\n", max_times[2]);
+    fprintf(stdout, "Tempo de Comunicação (Máximo entre processos): %.6f segundos\n", max_times[3]);
+    report_verification(stdout, in_order, is_permutation, max_times[4]);
+    fprintf(stdout, "O array final está ordenado: %s\n", (in_order && is_permutation) ? "Sim" : "Não");
+}
+
+// Modo arquivo (MPI-IO): ordena um arquivo binário de chaves int32 (ordem de bytes nativa).
+// Cada processo lê sua fatia com MPI_File_read_at_all, ordena e grava o bloco ordenado na mesma
+// posição do arquivo de saída com MPI_File_write_at_all; nenhum processo mantém o array completo
+// e a verificação final é distribuída. Retorna EXIT_SUCCESS ou EXIT_FAILURE (em todos os processos).
+// Os demais tipos de chave usam sort_binary_file_mpi_io_<tipo>, logo abaixo.
+int sort_binary_file_mpi_io(const char *input_path, const char *output_path, const char *exchange_mode,
+                            const char *partition_mode, int chunk_elements, int check_interval,
+                            int total_processes, int current_rank) {
+    MPI_File input_file;
+    MPI_Offset file_bytes;
+    int overall_array_size;
+    if (!open_binary_key_file(input_path, sizeof(int), "int32", total_processes, current_rank, &input_file,
+                              &file_bytes, &overall_array_size)) {
+        return EXIT_FAILURE;
+    }
+
+    int *block_counts = (int *)malloc(total_processes * sizeof(int));
+    int *block_displs = (int *)malloc(total_processes * sizeof(int));
+    if (block_counts == NULL || block_displs == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação do particionamento no rank %d.\n", current_rank);
+        MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+    }
+    build_partition(partition_mode, overall_array_size, total_processes, block_counts, block_displs);
+    if (strcmp(exchange_mode, "sobreposto") == 0) {
+        chunk_elements = chunk_elements_within_tag_limit(block_counts, total_processes, chunk_elements, current_rank);
+    }
+    int local_data_size = block_counts[current_rank];
+    MPI_Offset local_offset = (MPI_Offset)block_displs[current_rank] * (MPI_Offset)sizeof(int);
+
+    int *local_block = (int *)malloc(local_data_size * sizeof(int));
+    if (local_block == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para o array local no rank %d.\n", current_rank);
+        MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+    }
+
+    double read_start = MPI_Wtime();
+    if (!read_binary_key_file(input_path, &input_file, local_offset, local_block, local_data_size, MPI_INT,
+                              current_rank)) {
+        free(local_block);
+        free(block_counts);
+        free(block_displs);
+        return EXIT_FAILURE;
+    }
+    double read_time = MPI_Wtime() - read_start;
+    uint64_t input_checksum[MULTISET_CHECKSUM_WORDS];
+    multiset_checksum_clear(input_checksum);
+    multiset_checksum_int(local_block, local_data_size, input_checksum);
+
+    double sort_start = MPI_Wtime();
+    trace_perf_begin(0);
+    double local_comm_time = run_selected_sort(exchange_mode, local_block, overall_array_size, block_counts,
+                                               total_processes, current_rank, chunk_elements, check_interval);
+    trace_perf_end(0);
+    MPI_Barrier(MPI_COMM_WORLD);
+    double sort_time = MPI_Wtime() - sort_start;
+
+    double write_start = MPI_Wtime();
+    if (!write_binary_key_file(output_path, file_bytes, local_offset, local_block, local_data_size, MPI_INT,
+                               current_rank)) {
+        free(local_block);
+        free(block_counts);
+        free(block_displs);
+        return EXIT_FAILURE;
+    }
+    double write_time = MPI_Wtime() - write_start;
+
+    double verify_start = MPI_Wtime();
+    bool is_permutation;
+    bool in_order = distributed_verify_int(local_block, local_data_size, input_checksum, total_processes,
+                                           current_rank, MPI_INT, &is_permutation);
+    bool output_sorted = in_order && is_permutation;
+    double verify_time = MPI_Wtime() - verify_start;
+
+    double local_times[5] = { read_time, sort_time, write_time, local_comm_time, verify_time };
+    double max_times[5];
+    MPI_Reduce(local_times, max_times, 5, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    if (current_rank == 0) {
+        report_file_results(input_path, output_path, overall_array_size, total_processes, exchange_mode,
+                            partition_mode, "int", max_times, in_order, is_permutation);
+        fprintf(stderr, "Bloco Final (segmento no Rank 0): ");
+        display_array_segment(local_block, local_data_size, stderr);
+    }
+
+    free(local_block);
+    free(block_counts);
+    free(block_displs);
+    return output_sorted ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Modo arquivo para os demais tipos de chave (ODD_EVEN_KEY, sem payload): o arquivo contém chaves do
+// tipo escolhido na ordem de bytes nativa, lidas e gravadas com o tipo MPI correspondente
+// (MPI_INT64_T para int64, por exemplo) e ordenadas pelo modo tipado 'bloco' ou 'compartilhado'.
+#define DEFINE_TYPED_MPI_FILE(name, type)                                                              \
+int sort_binary_file_mpi_io_##name(const char *input_path, const char *output_path,                    \
+                                   const char *exchange_mode, const char *partition_mode,              \
+                                   int total_processes, int current_rank) {                            \
+    MPI_File input_file;                                                                               \
+    MPI_Offset file_bytes;                                                                             \
+    int overall_array_size;                                                                            \
+    if (!open_binary_key_file(input_path, sizeof(type), #name, total_processes, current_rank,          \
+                              &input_file, &file_bytes, &overall_array_size)) {                        \
+        return EXIT_FAILURE;                                                                           \
+    }                                                                                                  \
+    MPI_Datatype key_datatype = KEY_MPI_DATATYPE((type)0);                                             \
+    int *block_counts = (int *)malloc(total_processes * sizeof(int));                                  \
+    int *block_displs = (int *)malloc(total_processes * sizeof(int));                                  \
+    if (block_counts == NULL || block_displs == NULL) {                                                \
+        fprintf(stderr, "Erro: Falha na alocação do particionamento no rank %d.\n", current_rank);     \
+        MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);                                                       \
+    }                                                                                                  \
+    build_partition(partition_mode, overall_array_size, total_processes, block_counts, block_displs);  \
+    int local_data_size = block_counts[current_rank];                                                  \
+    MPI_Offset local_offset = (MPI_Offset)block_displs[current_rank] * (MPI_Offset)sizeof(type);       \
+    type *local_block = (type *)malloc(local_data_size * sizeof(type));                                \
+    if (local_block == NULL) {                                                                         \
+        fprintf(stderr, "Erro: Falha na alocação de memória para o array local no rank %d.\n", current_rank); \
+        MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);                                                       \
+    }                                                                                                  \
+                                                                                                       \
+    double read_start = MPI_Wtime();                                                                   \
+    if (!read_binary_key_file(input_path, &input_file, local_offset, local_block, local_data_size,     \
+                              key_datatype, current_rank)) {                                           \
+        free(local_block);                                                                             \
+        free(block_counts);                                                                            \
+        free(block_displs);                                                                            \
+        return EXIT_FAILURE;                                                                           \
+    }                                                                                                  \
+    double read_time = MPI_Wtime() - read_start;                                                       \
+    uint64_t input_checksum[MULTISET_CHECKSUM_WORDS];                                                  \
+    multiset_checksum_clear(input_checksum);                                                           \
+    multiset_checksum_##name(local_block, local_data_size, input_checksum);                            \
+                                                                                                       \
+    double sort_start = MPI_Wtime();                                                                   \
+    double local_comm_time = (strcmp(exchange_mode, "compartilhado") == 0)                             \
+        ? parallel_odd_even_sort_mpi_shared_##name(local_block, block_counts, total_processes, current_rank, \
+                                                key_datatype)                                          \
+        : parallel_odd_even_sort_mpi_blocks_##name(local_block, block_counts, total_processes, current_rank, \
+                                                key_datatype);                                         \
+    MPI_Barrier(MPI_COMM_WORLD);                                                                       \
+    double sort_time = MPI_Wtime() - sort_start;                                                       \
+                                                                                                       \
+    double write_start = MPI_Wtime();                                                                  \
+    if (!write_binary_key_file(output_path, file_bytes, local_offset, local_block, local_data_size,    \
+                               key_datatype, current_rank)) {                                          \
+        free(local_block);                                                                             \
+        free(block_counts);                                                                            \
+        free(block_displs);                                                                            \
+        return EXIT_FAILURE;                                                                           \
+    }                                                                                                  \
+    double write_time = MPI_Wtime() - write_start;                                                     \
+                                                                                                       \
+    double verify_start = MPI_Wtime();                                                                 \
+    bool is_permutation;                                                                               \
+    bool in_order = distributed_verify_##name(local_block, local_data_size, input_checksum,            \
+                                              total_processes, current_rank, key_datatype,             \
+                                              &is_permutation);                                        \
+    double verify_time = MPI_Wtime() - verify_start;                                                   \
+                                                                                                       \
+    double local_times[5] = { read_time, sort_time, write_time, local_comm_time, verify_time };         \
+    double max_times[5];                                                                               \
+    MPI_Reduce(local_times, max_times, 5, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);                     \
+    if (current_rank == 0) {                                                                           \
+        report_file_results(input_path, output_path, overall_array_size, total_processes, exchange_mode, \
+                            partition_mode, #name, max_times, in_order, is_permutation);               \
+        fprintf(stderr, "Bloco Final (segmento no Rank 0): ");                                         \
+        display_segment_##name(local_block, local_data_size, stderr);                                  \
+    }                                                                                                  \
+    free(local_block);                                                                                 \
+    free(block_counts);                                                                                \
+    free(block_displs);                                                                                \
+    return (in_order && is_permutation) ? EXIT_SUCCESS : EXIT_FAILURE;                                 \
+}
+
+ODD_EVEN_KEY_TYPES(DEFINE_TYPED_MPI_FILE)
+
+// Despacha o modo arquivo para o tipo de chave configurado (sem payload). Coletiva.
+int sort_typed_binary_file_mpi_io(const key_config *key_settings, const char *input_path, const char *output_path,
+                                  const char *exchange_mode, const char *partition_mode, int total_processes,
+                                  int current_rank) {
+    switch (key_settings->type) {
+#define TYPED_MPI_FILE_CASE(name, type)                                                                \
+    case KEY_TYPE_##name:                                                                              \
+        return sort_binary_file_mpi_io_##name(input_path, output_path, exchange_mode, partition_mode,  \
+                                              total_processes, current_rank);
+        ODD_EVEN_KEY_TYPES(TYPED_MPI_FILE_CASE)
+#undef TYPED_MPI_FILE_CASE
+    default:
+        return EXIT_FAILURE;
+    }
+}
+
 
 int main(int argc, char *argv[]) {
     // Inicializa o ambiente MPI
+#ifdef _OPENMP
+    // Híbrido: só a thread mestre faz chamadas MPI, então MPI_THREAD_FUNNELED basta
+    int provided_thread_level;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided_thread_level);
+    if (provided_thread_level < MPI_THREAD_FUNNELED) {
+        fprintf(stderr, "Erro: a biblioteca MPI não oferece suporte a MPI_THREAD_FUNNELED.\n");
+        MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+    }
+#else
     MPI_Init(&argc, &argv);
+#endif
 
-    // Validação de argumentos: Espera um argumento para o tamanho do array
-    if (argc != 2) {
-        fprintf(stderr, "Modo de uso: mpiexec -np <num_processos> %s <tamanho_array>\n", argv[0]);
+    // Modo arquivo: '-f <entrada.bin> <saida.bin>' substitui o tamanho do array (lido do arquivo)
+    const char *input_path = NULL, *output_path = NULL;
+    if (argc >= 4 && strcmp(argv[1], "-f") == 0) {
+        input_path = argv[2];
+        output_path = argv[3];
+    }
+    // Posição do primeiro argumento opcional: depois do tamanho do array ou de '-f' e dos dois caminhos
+    int optional_base = (input_path != NULL) ? 4 : 2;
+
+    // Validação de argumentos: tamanho do array e, opcionalmente, o modo de troca
+    // (no modo 'sobreposto': tamanho do pedaço e fases entre testes de convergência)
+    if (argc < optional_base || argc > optional_base + 3) {
+        fprintf(stderr, "Modo de uso: mpiexec -np <num_processos> %s <tamanho_array | -f entrada.bin saida.bin> "
+                        "[modo: bloco|elemento|sobreposto|compartilhado] [elementos_por_pedaco] [fases_entre_verificacoes]\n", argv[0]);
         MPI_Finalize();
         return EXIT_FAILURE;
     }
 
-    int overall_array_size = atoi(argv[1]); // Converte o tamanho do array de string para int
-    if (overall_array_size <= 0) {
-        fprintf(stderr, "Erro: O tamanho do array deve ser um número inteiro positivo.\n");
+    // 'bloco' (padrão): compare-split com troca de blocos inteiros, 'num_processos' fases
+    // 'elemento': versão original, troca um elemento de borda por fase
+    // 'sobreposto': blocos enviados em pedaços não bloqueantes, merge sobreposto à transferência
+    // 'compartilhado': como 'bloco', mas vizinhos do mesmo nó intercalam direto da janela compartilhada
+    const char *exchange_mode = (argc > optional_base) ? argv[optional_base] : "bloco";
+    if (strcmp(exchange_mode, "bloco") != 0 && strcmp(exchange_mode, "elemento") != 0 &&
+        strcmp(exchange_mode, "sobreposto") != 0 && strcmp(exchange_mode, "compartilhado") != 0) {
+        fprintf(stderr, "Erro: modo deve ser 'bloco', 'elemento', 'sobreposto' ou 'compartilhado'.\n");
+        MPI_Finalize();
+        return EXIT_FAILURE;
+    }
+    int chunk_elements = (argc > optional_base + 1) ? atoi(argv[optional_base + 1]) : 65536;
+    int check_interval = (argc > optional_base + 2) ? atoi(argv[optional_base + 2]) : 4;
+    // Uma janela precisa conter uma fase par e uma ímpar para concluir que o array está ordenado
+    if (chunk_elements <= 0 || check_interval < 2) {
+        fprintf(stderr, "Erro: o pedaço deve ser positivo e o intervalo de verificação pelo menos 2 fases.\n");
         MPI_Finalize();
         return EXIT_FAILURE;
     }
@@ -169,17 +1465,110 @@ int main(int argc, char *argv[]) {
     MPI_Comm_rank(MPI_COMM_WORLD, &process_rank); // Obtém o rank do processo atual
     MPI_Comm_size(MPI_COMM_WORLD, &num_mpi_processes); // Obtém o número total de processos
 
-    // Calcula o tamanho do segmento de array para cada processo
-    // Garante que o array seja divisível igualmente entre os processos
-    if (overall_array_size % num_mpi_processes != 0) {
+    // Instrumentação opcional: os processos se sincronizam para compartilhar a origem dos tempos
+    trace_init();
+    if (trace_enabled()) {
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+    trace_set_process(process_rank);
+
+    // Particionamento: 'uniforme' (padrão) divide o array em partes quase iguais (qualquer tamanho);
+    // 'calibrada' mede a velocidade de ordenação local de cada processo e dá blocos proporcionalmente
+    // menores aos processos mais lentos (ODD_EVEN_PARTITION=uniforme|calibrada)
+    const char *partition_mode = getenv("ODD_EVEN_PARTITION");
+    if (partition_mode == NULL) partition_mode = "uniforme";
+    if (strcmp(partition_mode, "uniforme") != 0 && strcmp(partition_mode, "calibrada") != 0) {
         if (process_rank == 0) {
-            fprintf(stderr, "Erro: O tamanho total do array (%d) deve ser divisível pelo número de processos (%d).\n",
+            fprintf(stderr, "Erro: ODD_EVEN_PARTITION deve ser 'uniforme' ou 'calibrada'.\n");
+        }
+        MPI_Finalize();
+        return EXIT_FAILURE;
+    }
+
+    // Tipo da chave (ODD_EVEN_KEY / ODD_EVEN_PAYLOAD): os demais tipos usam os modos 'bloco' e
+    // 'compartilhado', em memória ou (sem payload) no modo arquivo
+    key_config key_settings;
+    if (!read_key_config(&key_settings)) {
+        MPI_Finalize();
+        return EXIT_FAILURE;
+    }
+    if (!key_config_is_default(&key_settings) && strcmp(exchange_mode, "bloco") != 0 &&
+        strcmp(exchange_mode, "compartilhado") != 0) {
+        if (process_rank == 0) {
+            fprintf(stderr, "Erro: os modos 'elemento' e 'sobreposto' estão disponíveis apenas para chaves int "
+                            "sem payload.\n");
+        }
+        MPI_Finalize();
+        return EXIT_FAILURE;
+    }
+    if (input_path != NULL && key_settings.with_payload) {
+        if (process_rank == 0) {
+            fprintf(stderr, "Erro: o modo arquivo aceita apenas chaves sem payload.\n");
+        }
+        MPI_Finalize();
+        return EXIT_FAILURE;
+    }
+
+    if (input_path != NULL) {
+        int file_status = key_config_is_default(&key_settings)
+                              ? sort_binary_file_mpi_io(input_path, output_path, exchange_mode, partition_mode,
+                                                        chunk_elements, check_interval, num_mpi_processes,
+                                                        process_rank)
+                              : sort_typed_binary_file_mpi_io(&key_settings, input_path, output_path, exchange_mode,
+                                                              partition_mode, num_mpi_processes, process_rank);
+        finish_trace_mpi(num_mpi_processes, process_rank);
+        MPI_Finalize();
+        return file_status;
+    }
+
+    int overall_array_size = atoi(argv[1]); // Converte o tamanho do array de string para int
+    if (overall_array_size <= 0) {
+        fprintf(stderr, "Erro: O tamanho do array deve ser um número inteiro positivo.\n");
+        MPI_Finalize();
+        return EXIT_FAILURE;
+    }
+
+    // Cada processo precisa de pelo menos um elemento
+    if (overall_array_size < num_mpi_processes) {
+        if (process_rank == 0) {
+            fprintf(stderr, "Erro: O tamanho total do array (%d) deve ser pelo menos o número de processos (%d).\n",
                     overall_array_size, num_mpi_processes);
         }
         MPI_Finalize();
         return EXIT_FAILURE;
     }
-    int local_data_size = overall_array_size / num_mpi_processes;
+
+    int *block_counts = (int *)malloc(num_mpi_processes * sizeof(int));
+    int *block_displs = (int *)malloc(num_mpi_processes * sizeof(int));
+    if (block_counts == NULL || block_displs == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação do particionamento no rank %d.\n", process_rank);
+        MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+    }
+    build_partition(partition_mode, overall_array_size, num_mpi_processes, block_counts, block_displs);
+    if (strcmp(exchange_mode, "sobreposto") == 0) {
+        chunk_elements = chunk_elements_within_tag_limit(block_counts, num_mpi_processes, chunk_elements,
+                                                         process_rank);
+    }
+    int local_data_size = block_counts[process_rank];
+
+    // Distribuição e semente da entrada (ODD_EVEN_DIST / ODD_EVEN_SEED); sem semente explícita,
+    // vale a do relógio do rank 0, difundida para que todos gerem a mesma entrada
+    input_config input_settings;
+    if (!read_input_config(&input_settings)) {
+        MPI_Finalize();
+        return EXIT_FAILURE;
+    }
+    MPI_Bcast(&input_settings.seed, 1, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+
+    if (!key_config_is_default(&key_settings)) {
+        int typed_status = run_typed_mpi(&key_settings, overall_array_size, block_counts, block_displs,
+                                         num_mpi_processes, process_rank, &input_settings, exchange_mode);
+        free(block_counts);
+        free(block_displs);
+        finish_trace_mpi(num_mpi_processes, process_rank);
+        MPI_Finalize();
+        return typed_status;
+    }
 
     int *full_array_master = NULL; // Ponteiro para o array global (apenas no processo raiz)
     int *local_array_segment_ptr = (int *)malloc(local_data_size * sizeof(int)); // Array local para cada processo
@@ -191,7 +1580,7 @@ int main(int argc, char *argv[]) {
         return EXIT_FAILURE;
     }
 
-    // O processo raiz (rank 0) gera o array completo e o imprime (opcionalmente)
+    // O processo raiz (rank 0) só aloca o array global que recebe o resultado
     if (process_rank == 0) {
         full_array_master = (int *)malloc(overall_array_size * sizeof(int));
         if (full_array_master == NULL) {
@@ -200,22 +1589,34 @@ int main(int argc, char *argv[]) {
             MPI_Finalize();
             return EXIT_FAILURE;
         }
-        fill_with_random_elements(full_array_master, overall_array_size, 1000); // Preenche com valores aleatórios
+    }
 
+    // Cada processo gera o próprio segmento pelo gerador por contador: a entrada global é a mesma
+    // para qualquer número de processos e dispensa o Scatterv a partir do rank 0
+    fill_input_range(local_array_segment_ptr, block_displs[process_rank], local_data_size,
+                     overall_array_size, &input_settings);
+    // Assinatura de multiconjunto do segmento de entrada, para a verificação de permutação
+    uint64_t input_checksum[MULTISET_CHECKSUM_WORDS];
+    multiset_checksum_clear(input_checksum);
+    multiset_checksum_int(local_array_segment_ptr, local_data_size, input_checksum);
+    if (process_rank == 0) {
+        report_input_config(&input_settings, stderr);
         fprintf(stderr, "Array inicial (segmento no Rank 0): ");
-        display_array_segment(full_array_master, overall_array_size, stderr);
+        display_array_segment(local_array_segment_ptr, local_data_size, stderr);
     }
 
-    // Distribui o array global em segmentos locais para cada processo
-    MPI_Scatter(full_array_master, local_data_size, MPI_INT,
-                local_array_segment_ptr, local_data_size, MPI_INT, 0, MPI_COMM_WORLD);
-
     double start_wall_time = MPI_Wtime(); // Início da medição de tempo de execução
     
     // Executa a ordenação Odd-Even Transposition Sort paralela
-    double local_comm_time = parallel_odd_even_sort_mpi(local_array_segment_ptr, full_array_master,
-                                                         overall_array_size, local_data_size,
-                                                         num_mpi_processes, process_rank);
+    trace_perf_begin(0);
+    double local_comm_time = run_selected_sort(exchange_mode, local_array_segment_ptr, overall_array_size,
+                                               block_counts, num_mpi_processes, process_rank,
+                                               chunk_elements, check_interval);
+    trace_perf_end(0);
+
+    // Coleta todos os segmentos locais no processo raiz (rank 0) para formar o array global ordenado
+    MPI_Gatherv(local_array_segment_ptr, local_data_size, MPI_INT,
+                full_array_master, block_counts, block_displs, MPI_INT, 0, MPI_COMM_WORLD);
     
     MPI_Barrier(MPI_COMM_WORLD); // Sincroniza todos os processos antes de finalizar a medição de tempo
     double end_wall_time = MPI_Wtime(); // Fim da medição de tempo de execução
@@ -229,11 +1630,34 @@ int main(int argc, char *argv[]) {
     MPI_Reduce(&local_comm_time, &summed_comm_time_all_procs, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
     MPI_Reduce(&total_execution_time, &max_total_time_across_procs, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
 
+    // Coleta, por processo, o tempo de espera de comunicação e o tempo total (computação = total - espera)
+    double rank_times[2] = { local_comm_time, total_execution_time };
+    double *all_rank_times = NULL;
+    if (process_rank == 0) {
+        all_rank_times = (double *)malloc(2 * num_mpi_processes * sizeof(double));
+    }
+    MPI_Gather(rank_times, 2, MPI_DOUBLE, all_rank_times, 2, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+    // Verificação distribuída sobre os blocos locais (não usa o array reunido no rank 0)
+    double verify_start = MPI_Wtime();
+    bool is_permutation;
+    bool in_order = distributed_verify_int(local_array_segment_ptr, local_data_size, input_checksum,
+                                           num_mpi_processes, process_rank, MPI_INT, &is_permutation);
+    double verify_time = MPI_Wtime() - verify_start;
+
     // O processo raiz imprime os resultados e verifica a ordenação final
     if (process_rank == 0) {
         fprintf(stdout, "\n--- Resultados da Execução MPI ---\n");
         fprintf(stdout, "Tamanho do Array: %d\n", overall_array_size);
         fprintf(stdout, "Número de Processos MPI: %d\n", num_mpi_processes);
+        fprintf(stdout, "Modo de Troca: %s\n", exchange_mode);
+        fprintf(stdout, "Particionamento: %s\n", partition_mode);
+        if (strcmp(exchange_mode, "sobreposto") == 0) {
+            fprintf(stdout, "Elementos por Pedaço: %d, Fases entre Verificações: %d\n", chunk_elements, check_interval);
+        }
+#ifdef _OPENMP
+        fprintf(stdout, "Threads OpenMP por Processo: %d\n", omp_get_max_threads());
+#endif
         fprintf(stdout, "Tempo de Execução Total (Máximo entre processos): %.6f segundos\n", max_total_time_across_procs);
         fprintf(stdout, "Tempo de Comunicação Total (Soma entre processos): %.6f segundos\n", summed_comm_time_all_procs);
         
@@ -243,8 +1667,16 @@ int main(int argc, char *argv[]) {
         } else {
             fprintf(stdout, "Overhead de Comunicação: N/A (tempo de execução total zero)\n");
         }
+
+        for (int rank = 0; all_rank_times != NULL && rank < num_mpi_processes; ++rank) {
+            fprintf(stdout, "Rank %d: %d elementos, espera de comunicação %.6f s, computação %.6f s\n", rank,
+                    block_counts[rank], all_rank_times[2 * rank],
+                    all_rank_times[2 * rank + 1] - all_rank_times[2 * rank]);
+        }
+        free(all_rank_times);
         
-        fprintf(stdout, "O array final está ordenado: %s\n", check_if_data_is_sorted(full_array_master, overall_array_size) ? "Sim" : "Não");
+        report_verification(stdout, in_order, is_permutation, verify_time);
+        fprintf(stdout, "O array final está ordenado: %s\n", (in_order && is_permutation) ? "Sim" : "Não");
 
         fprintf(stderr, "Array Final (segmento no Rank 0): ");
         display_array_segment(full_array_master, overall_array_size, stderr);
@@ -257,8 +1689,12 @@ int main(int argc, char *argv[]) {
     }
     free(local_array_segment_ptr);
     local_array_segment_ptr = NULL;
+    free(block_counts);
+    free(block_displs);
+
+    finish_trace_mpi(num_mpi_processes, process_rank);
 
-    // Finaliza o ambiente MPI
+    // Finaliza o ambiente MPI; a verificação é coletiva, então todos os processos saem com o mesmo código
     MPI_Finalize();
-    return EXIT_SUCCESS;
+    return (in_order && is_permutation) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
\ No newline at end of file
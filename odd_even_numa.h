@@ -0,0 +1,284 @@
+#ifndef ODD_EVEN_NUMA_H
+#define ODD_EVEN_NUMA_H
+
+// Posicionamento de memória e de threads para a versão OpenMP em máquinas NUMA (vários soquetes).
+//
+// Com malloc e preenchimento serial, todas as páginas do array ficam no nó NUMA da thread mestre e,
+// a cada fase, metade das threads lê memória remota. Aqui as páginas são tocadas pela primeira vez
+// em paralelo, com a mesma partição estática usada pelas fases, para que o kernel as aloque no nó de
+// quem vai usá-las. Variáveis de ambiente:
+//   ODD_EVEN_PLACEMENT=primeiro_toque|ingenuo   primeiro toque paralelo (padrão) ou alocação serial
+//   ODD_EVEN_HUGEPAGES=nao|transparente|explicita
+//                                               páginas normais (padrão), THP via madvise(MADV_HUGEPAGE)
+//                                               ou páginas enormes reservadas (MAP_HUGETLB, com recuo
+//                                               para THP se não houver páginas reservadas)
+//   ODD_EVEN_PIN=nao|compacto|espalhado         fixa cada thread em uma CPU quando OMP_PROC_BIND não
+//                                               está definido; com OMP_PROC_BIND/OMP_PLACES o runtime
+//                                               OpenMP faz a fixação e esta opção é ignorada
+// A topologia (nós, CPUs, fixação das threads e distribuição das páginas do array por nó) é
+// impressa em stderr no início da execução.
+//
+// Requer _GNU_SOURCE (sched_getcpu, CPU_SET, MAP_HUGETLB) definido antes do primeiro #include.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <omp.h>
+#include "odd_even_input.h"
+
+#define NUMA_HUGE_PAGE_BYTES ((size_t)2 << 20)
+#define NUMA_MAX_CPUS 4096
+#define NUMA_MAX_NODES 64
+#define NUMA_PAGE_SAMPLES 4096
+
+typedef enum { PLACEMENT_FIRST_TOUCH, PLACEMENT_NAIVE } memory_placement;
+typedef enum { HUGE_PAGES_NONE, HUGE_PAGES_TRANSPARENT, HUGE_PAGES_EXPLICIT } huge_page_mode;
+typedef enum { PIN_NONE, PIN_COMPACT, PIN_SPREAD } thread_pinning;
+
+static const char *const memory_placement_names[] = { "primeiro_toque", "ingenuo" };
+static const char *const huge_page_mode_names[] = { "nao", "transparente", "explicita" };
+static const char *const thread_pinning_names[] = { "nao", "compacto", "espalhado" };
+
+typedef struct {
+    memory_placement placement;
+    huge_page_mode huge_pages;
+    thread_pinning pinning;
+} numa_config;
+
+// Array alocado por allocate_sort_array; 'mapped' indica se deve ser liberado com munmap
+typedef struct {
+    int *data;
+    size_t bytes;
+    int mapped;
+    huge_page_mode huge_pages; // Modo efetivamente obtido (pode ter recuado)
+} sort_array;
+
+static inline int parse_numa_option(const char *variable, const char *const names[], int name_count, int *value) {
+    const char *text = getenv(variable);
+    *value = 0;
+    if (text == NULL) {
+        return 1;
+    }
+    for (int i = 0; i < name_count; ++i) {
+        if (strcmp(text, names[i]) == 0) {
+            *value = i;
+            return 1;
+        }
+    }
+    fprintf(stderr, "Erro: valor '%s' inválido para %s (use", text, variable);
+    for (int i = 0; i < name_count; ++i) fprintf(stderr, "%s %s", i ? "," : "", names[i]);
+    fprintf(stderr, ").\n");
+    return 0;
+}
+
+// Lê ODD_EVEN_PLACEMENT, ODD_EVEN_HUGEPAGES e ODD_EVEN_PIN; retorna 0 (com mensagem) se algum for inválido
+static inline int read_numa_config(numa_config *config) {
+    int placement, huge_pages, pinning;
+    if (!parse_numa_option("ODD_EVEN_PLACEMENT", memory_placement_names, 2, &placement) ||
+        !parse_numa_option("ODD_EVEN_HUGEPAGES", huge_page_mode_names, 3, &huge_pages) ||
+        !parse_numa_option("ODD_EVEN_PIN", thread_pinning_names, 3, &pinning)) {
+        return 0;
+    }
+    config->placement = (memory_placement)placement;
+    config->huge_pages = (huge_page_mode)huge_pages;
+    config->pinning = (thread_pinning)pinning;
+    return 1;
+}
+
+// Aloca o array conforme o modo de páginas enormes. Nenhuma página é tocada aqui: o primeiro toque
+// (first_touch_fill_sort_array ou o preenchimento) decide o nó NUMA de cada uma.
+static inline int allocate_sort_array(sort_array *array, size_t elements, huge_page_mode huge_pages) {
+    array->bytes = elements * sizeof(int);
+    array->mapped = 0;
+    array->huge_pages = huge_pages;
+    array->data = NULL;
+#ifdef MAP_HUGETLB
+    if (huge_pages == HUGE_PAGES_EXPLICIT) {
+        size_t rounded = (array->bytes + NUMA_HUGE_PAGE_BYTES - 1) / NUMA_HUGE_PAGE_BYTES * NUMA_HUGE_PAGE_BYTES;
+        void *mapping = mmap(NULL, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (mapping != MAP_FAILED) {
+            array->data = (int *)mapping;
+            array->bytes = rounded;
+            array->mapped = 1;
+            return 1;
+        }
+        fprintf(stderr, "Aviso: MAP_HUGETLB falhou (sem páginas enormes reservadas em "
+                        "/proc/sys/vm/nr_hugepages?); usando páginas enormes transparentes.\n");
+        array->huge_pages = huge_pages = HUGE_PAGES_TRANSPARENT;
+    }
+#endif
+    if (huge_pages != HUGE_PAGES_NONE) {
+        // THP exige regiões alinhadas a 2 MiB
+        void *aligned = NULL;
+        if (posix_memalign(&aligned, NUMA_HUGE_PAGE_BYTES, array->bytes > 0 ? array->bytes : 1) != 0) {
+            return 0;
+        }
+#ifdef MADV_HUGEPAGE
+        madvise(aligned, array->bytes, MADV_HUGEPAGE);
+#endif
+        array->data = (int *)aligned;
+        return 1;
+    }
+    array->data = (int *)malloc(array->bytes > 0 ? array->bytes : 1);
+    return array->data != NULL;
+}
+
+static inline void free_sort_array(sort_array *array) {
+    if (array->mapped) {
+        munmap(array->data, array->bytes);
+    } else {
+        free(array->data);
+    }
+    array->data = NULL;
+}
+
+// Primeiro toque paralelo: cada thread gera (pelo gerador por contador) os pedaços de 'chunk_elements'
+// elementos que a partição estática das fases lhe atribui, de modo que as páginas sejam alocadas no
+// seu nó NUMA já com os valores da entrada
+static inline void first_touch_fill_sort_array(int data[], long elements, long chunk_elements, int num_threads,
+                                               const input_config *config) {
+    long chunk_count = (elements + chunk_elements - 1) / chunk_elements;
+    #pragma omp parallel for schedule(static) num_threads(num_threads)
+    for (long chunk = 0; chunk < chunk_count; ++chunk) {
+        long first = chunk * chunk_elements;
+        long count = (elements - first < chunk_elements) ? elements - first : chunk_elements;
+        fill_input_range(data + first, first, count, elements, config);
+    }
+}
+
+// Converte uma lista de CPUs do sysfs ("0-3,8-11") marcando 'node' em cpu_nodes
+static inline void numa_parse_cpu_list(const char *list, int node, int cpu_nodes[]) {
+    const char *cursor = list;
+    while (*cursor != '\0' && *cursor != '\n') {
+        char *after;
+        long first = strtol(cursor, &after, 10), last = first;
+        if (after == cursor) break;
+        if (*after == '-') {
+            cursor = after + 1;
+            last = strtol(cursor, &after, 10);
+        }
+        for (long cpu = first; cpu <= last && cpu < NUMA_MAX_CPUS; ++cpu) {
+            if (cpu >= 0) cpu_nodes[cpu] = node;
+        }
+        cursor = (*after == ',') ? after + 1 : after;
+    }
+}
+
+// Mapa CPU -> nó NUMA lido de /sys/devices/system/node; retorna o número de nós (1 se indisponível)
+static inline int numa_read_topology(int cpu_nodes[], char node_cpus[][256]) {
+    int node_count = 0;
+    for (int cpu = 0; cpu < NUMA_MAX_CPUS; ++cpu) cpu_nodes[cpu] = 0;
+    for (int node = 0; node < NUMA_MAX_NODES; ++node) {
+        char path[96];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        FILE *list_file = fopen(path, "r");
+        if (list_file == NULL) continue;
+        if (fgets(node_cpus[node], 256, list_file) != NULL) {
+            node_cpus[node][strcspn(node_cpus[node], "\n")] = '\0';
+            numa_parse_cpu_list(node_cpus[node], node, cpu_nodes);
+            node_count = node + 1;
+        }
+        fclose(list_file);
+    }
+    return node_count > 0 ? node_count : 1;
+}
+
+// Fixa as threads OpenMP (quando OMP_PROC_BIND não está ativo) nas CPUs permitidas ao processo:
+// 'compacto' ocupa CPUs consecutivas, 'espalhado' distribui as threads por toda a lista (e portanto
+// por todos os nós). O runtime reaproveita as mesmas threads nas regiões paralelas seguintes.
+static inline void pin_openmp_threads(thread_pinning pinning, int num_threads) {
+    if (pinning == PIN_NONE || omp_get_proc_bind() != omp_proc_bind_false) {
+        return;
+    }
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return;
+    }
+    int allowed_cpus[CPU_SETSIZE], allowed_count = 0;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &allowed)) allowed_cpus[allowed_count++] = cpu;
+    }
+    if (allowed_count == 0) {
+        return;
+    }
+    #pragma omp parallel num_threads(num_threads)
+    {
+        int thread_id = omp_get_thread_num();
+        int slot = (pinning == PIN_SPREAD) ? (int)((long)thread_id * allowed_count / omp_get_num_threads())
+                                           : thread_id % allowed_count;
+        cpu_set_t target;
+        CPU_ZERO(&target);
+        CPU_SET(allowed_cpus[slot], &target);
+        sched_setaffinity(0, sizeof(target), &target); // pid 0: a própria thread
+    }
+}
+
+// Imprime em stderr a topologia, a fixação das threads e em que nós estão as páginas do array
+static inline void report_numa_topology(FILE *output_stream, const numa_config *config, const sort_array *array,
+                                        int num_threads) {
+    static int cpu_nodes[NUMA_MAX_CPUS];
+    static char node_cpus[NUMA_MAX_NODES][256];
+    int node_count = numa_read_topology(cpu_nodes, node_cpus);
+
+    fprintf(output_stream, "Topologia: %d nó(s) NUMA, %ld CPUs online", node_count, sysconf(_SC_NPROCESSORS_ONLN));
+    for (int node = 0; node < node_count && node_count > 1; ++node) {
+        fprintf(output_stream, "%s nó %d: CPUs %s", node ? ";" : " (", node, node_cpus[node]);
+    }
+    fprintf(output_stream, "%s\n", node_count > 1 ? ")" : "");
+    fprintf(output_stream, "Memória: posicionamento %s, páginas enormes %s%s\n",
+            memory_placement_names[config->placement], huge_page_mode_names[array->huge_pages],
+            (array->huge_pages != config->huge_pages) ? " (recuo de 'explicita')" : "");
+
+    static const char *const bind_names[] = { "false", "true", "master", "close", "spread" };
+    int bind = (int)omp_get_proc_bind();
+    fprintf(output_stream, "Threads: OMP_PROC_BIND=%s, %d lugares OpenMP, fixação própria %s\n",
+            (bind >= 0 && bind <= 4) ? bind_names[bind] : "?", omp_get_num_places(),
+            (bind == omp_proc_bind_false) ? thread_pinning_names[config->pinning] : "ignorada");
+    int *thread_cpus = (int *)malloc(num_threads * sizeof(int));
+    if (thread_cpus != NULL) {
+        #pragma omp parallel num_threads(num_threads)
+        thread_cpus[omp_get_thread_num()] = sched_getcpu();
+        fprintf(output_stream, "CPU (nó) de cada thread:");
+        for (int thread = 0; thread < num_threads; ++thread) {
+            int cpu = thread_cpus[thread];
+            fprintf(output_stream, " %d:%d(%d)", thread, cpu, (cpu >= 0 && cpu < NUMA_MAX_CPUS) ? cpu_nodes[cpu] : -1);
+        }
+        fprintf(output_stream, "\n");
+        free(thread_cpus);
+    }
+
+#ifdef SYS_move_pages
+    // move_pages com nós NULL apenas consulta o nó de cada página (amostra de até NUMA_PAGE_SAMPLES)
+    long page_size = sysconf(_SC_PAGESIZE);
+    long page_count = (long)((array->bytes + page_size - 1) / page_size);
+    long sample_count = (page_count < NUMA_PAGE_SAMPLES) ? page_count : NUMA_PAGE_SAMPLES;
+    void **pages = (void **)malloc(sample_count * sizeof(void *));
+    int *page_status = (int *)malloc(sample_count * sizeof(int));
+    if (pages != NULL && page_status != NULL && sample_count > 0) {
+        for (long sample = 0; sample < sample_count; ++sample) {
+            pages[sample] = (char *)array->data + (page_count * sample / sample_count) * page_size;
+        }
+        if (syscall(SYS_move_pages, 0, sample_count, pages, NULL, page_status, 0) == 0) {
+            long per_node[NUMA_MAX_NODES] = { 0 }, unknown = 0;
+            for (long sample = 0; sample < sample_count; ++sample) {
+                if (page_status[sample] >= 0 && page_status[sample] < NUMA_MAX_NODES) per_node[page_status[sample]]++;
+                else unknown++;
+            }
+            fprintf(output_stream, "Páginas do array por nó (amostra de %ld):", sample_count);
+            for (int node = 0; node < node_count; ++node) {
+                fprintf(output_stream, " nó %d: %.1f%%", node, 100.0 * per_node[node] / sample_count);
+            }
+            if (unknown > 0) fprintf(output_stream, " não alocadas/desconhecidas: %.1f%%", 100.0 * unknown / sample_count);
+            fprintf(output_stream, "\n");
+        }
+    }
+    free(pages);
+    free(page_status);
+#endif
+}
+
+#endif // ODD_EVEN_NUMA_H
@@ -1,15 +1,21 @@
+#define _GNU_SOURCE      // Para sched_getcpu e afinidade de threads (odd_even_numa.h)
 #include <stdio.h>
 #include <stdlib.h>
-#include <string.h>  // Para strcmp
-#include <time.h>
+#include <string.h>  // Para strcmp e memcpy
+#include <stdbool.h> // Para o compare-and-swap atômico do modo 'fluxo'
+#include <sched.h>   // Para sched_yield
 #include <omp.h>
+#include "odd_even_kernel.h" // Kernel de compare-exchange (AVX2/SSE4.1/escalar)
+#include "odd_even_input.h"  // Entrada reprodutível (distribuição e semente)
+#include "odd_even_trace.h"  // Instrumentação opcional (ODD_EVEN_TRACE / ODD_EVEN_PERF)
+#include "odd_even_numa.h"   // Primeiro toque, páginas enormes e fixação de threads
+#include "odd_even_batch.h"  // Ordenação em lote de muitos arrays pequenos
+#include "odd_even_incremental.h" // Array ordenado que absorve lotes anexados
+#include "odd_even_keys.h"   // Chaves tipadas e registros (ODD_EVEN_KEY / ODD_EVEN_PAYLOAD)
+#include "odd_even_tune.h"   // Perfil da máquina para o modo 'auto' (autotune.py / ODD_EVEN_PROFILE)
 
-// Troca dois valores inteiros
-void swap_values(int *first_val_ptr, int *second_val_ptr) {
-    int holding_value = *first_val_ptr;
-    *first_val_ptr = *second_val_ptr;
-    *second_val_ptr = holding_value;
-}
+// Quantidade de pares processados por iteração do laço de fases (unidade de escalonamento)
+#define PAIRS_PER_CHUNK 1024
 
 // Exibe até 20 elementos do array
 void display_array_segment(int target_array[], int array_length, FILE *output_stream) {
@@ -24,107 +30,869 @@ void display_array_segment(int target_array[], int array_length, FILE *output_st
     }
 }
 
-// Preenche array com inteiros aleatórios
-void fill_with_random_numbers(int dest_array[], int total_items, int max_possible_value) {
-    srand(time(NULL));
-    for (int i = 0; i < total_items; ++i) {
-        dest_array[i] = rand() % max_possible_value;
+// Verificação do lote em uma passada paralela: assinatura de multiconjunto dos pares (array, chave),
+// que detecta também chaves que mudaram de array, e, com 'disordered_arrays' != NULL, a contagem
+// dos arrays fora de ordem
+void batch_verification_pass(const int keys[], const long offsets[], int batch_count, int num_threads,
+                             uint64_t checksum[], long *disordered_arrays) {
+    uint64_t first_sum = 0, second_sum = 0;
+    long disordered = 0;
+    #pragma omp parallel for schedule(dynamic, 64) num_threads(num_threads) \
+        reduction(+:first_sum, second_sum, disordered)
+    for (int array_idx = 0; array_idx < batch_count; ++array_idx) {
+        int array_disordered = 0; // Cada array conta uma vez, qualquer que seja o número de pares fora de ordem
+        for (long key_idx = offsets[array_idx]; key_idx < offsets[array_idx + 1]; ++key_idx) {
+            uint64_t bits = ((uint64_t)array_idx << 32) | (uint32_t)keys[key_idx];
+            first_sum += multiset_mix_first(bits);
+            second_sum += multiset_mix_second(bits);
+            array_disordered |= (key_idx > offsets[array_idx] && keys[key_idx] < keys[key_idx - 1]);
+        }
+        disordered += array_disordered;
     }
+    checksum[0] += first_sum;
+    checksum[1] += second_sum;
+    if (disordered_arrays != NULL) *disordered_arrays = disordered;
 }
 
-// Verifica se array está ordenado
-int check_if_sorted(int data_array_ptr[], int array_count) {
-    for (int idx_check = 0; idx_check < array_count - 1; ++idx_check) {
-        if (data_array_ptr[idx_check] > data_array_ptr[idx_check + 1]) {
-            return 0;
+// Merge-split: intercala os blocos ordenados 'own' e 'partner' e grava em 'output' os 'own_size'
+// MENORES (keep_lower != 0) ou MAIORES (keep_lower == 0) elementos.
+// Retorna quantos elementos do vizinho entraram no bloco (0 se nenhum).
+int merge_split_blocks(const int own[], int own_size, const int partner[], int partner_size,
+                       int output[], int keep_lower) {
+    int moved = 0;
+    if (keep_lower) {
+        int own_idx = 0, partner_idx = 0;
+        for (int out_idx = 0; out_idx < own_size; ++out_idx) {
+            if (partner_idx < partner_size && partner[partner_idx] < own[own_idx]) {
+                output[out_idx] = partner[partner_idx++];
+                moved++;
+            } else {
+                output[out_idx] = own[own_idx++];
+            }
+        }
+    } else {
+        int own_idx = own_size - 1, partner_idx = partner_size - 1;
+        for (int out_idx = own_size - 1; out_idx >= 0; --out_idx) {
+            if (partner_idx >= 0 && partner[partner_idx] > own[own_idx]) {
+                output[out_idx] = partner[partner_idx--];
+                moved++;
+            } else {
+                output[out_idx] = own[own_idx--];
+            }
         }
     }
-    return 1;
+    return moved;
 }
 
-void parallel_odd_even_sort(int array[], int n, int num_threads, const char *policy) {
-    omp_set_num_threads(num_threads);
+// Odd-Even por blocos: cada thread possui um bloco contíguo, ordena-o localmente e, a cada
+// rodada, faz merge-split apenas com o vizinho. As duas threads de um par intercalam em paralelo
+// (uma produz a metade inferior, a outra a superior) em um buffer auxiliar; cada bloco guarda em
+// qual dos dois buffers está seu conteúdo atual, evitando cópias. Há uma única barreira por rodada
+// e a ordenação termina assim que duas rodadas consecutivas não alteram nenhum bloco.
+void block_odd_even_sort(int array[], int n, int num_threads) {
+    int block_count = (num_threads < n) ? num_threads : n;
+    int *scratch = (int *)malloc(n * sizeof(int));
+    // Flags de alteração por rodada (3 rodadas em anel) e localização dos blocos (2 rodadas em anel)
+    unsigned char *round_changed = (unsigned char *)calloc(3 * block_count, sizeof(unsigned char));
+    unsigned char *block_location = (unsigned char *)calloc(2 * block_count, sizeof(unsigned char));
+    if (scratch == NULL || round_changed == NULL || block_location == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o modo por blocos.\n");
+        exit(EXIT_FAILURE);
+    }
+    int *buffers[2] = { array, scratch };
+    // Com blocos de mesmo tamanho, 'block_count' rodadas garantem a ordenação
+    int uniform_blocks = (n % block_count == 0);
+    int tracing = trace_enabled();
 
-    #pragma omp parallel
+    #pragma omp parallel num_threads(block_count)
     {
-        for (int phase = 0; phase < n; ++phase) {
-            if (strcmp(policy, "static") == 0) {
-                #pragma omp for schedule(static)
-                for (int i = (phase % 2); i < n - 1; i += 2) {
-                    if (array[i] > array[i + 1]) {
-                        swap_values(&array[i], &array[i + 1]);
+        int tid = omp_get_thread_num();
+        int my_start = (int)((long long)n * tid / block_count);
+        int my_size = (int)((long long)n * (tid + 1) / block_count) - my_start;
+        int my_location = 0; // 0: bloco atual em 'array'; 1: em 'scratch'
+        trace_perf_begin(tid);
+
+        double sort_start = tracing ? trace_now_us() : 0.0;
+        sort_int(array + my_start, my_size);
+        double barrier_start = tracing ? trace_now_us() : 0.0;
+        #pragma omp barrier
+        if (tracing) {
+            trace_record(tid, TRACE_LOCAL_SORT, -1, sort_start, barrier_start, 0.0, 0, 0, 0);
+            trace_record(tid, TRACE_BARRIER, -1, barrier_start, trace_now_us(), 0.0, 0, 0, 0);
+        }
+
+        for (int round = 0; block_count > 1; ++round) {
+            const unsigned char *location_now = block_location + (round % 2) * block_count;
+            unsigned char *location_next = block_location + ((round + 1) % 2) * block_count;
+            my_location = location_now[tid];
+            int changed = 0;
+            double merge_start = tracing ? trace_now_us() : 0.0;
+            long long merge_steps = 0, moved = 0;
+
+            // Rodada par: pares (0,1), (2,3)...; rodada ímpar: (1,2), (3,4)...
+            int partner = (round % 2 == tid % 2) ? tid + 1 : tid - 1;
+            if (partner >= 0 && partner < block_count) {
+                int partner_start = (int)((long long)n * partner / block_count);
+                int partner_size = (int)((long long)n * (partner + 1) / block_count) - partner_start;
+                const int *own = buffers[my_location] + my_start;
+                const int *other = buffers[location_now[partner]] + partner_start;
+                // Se a fronteira já está em ordem, nenhum elemento muda de bloco
+                int boundary_ordered = (tid < partner) ? (own[my_size - 1] <= other[0])
+                                                       : (other[partner_size - 1] <= own[0]);
+                if (!boundary_ordered) {
+                    int *output = buffers[1 - my_location] + my_start;
+                    moved = merge_split_blocks(own, my_size, other, partner_size, output, tid < partner);
+                    merge_steps = my_size;
+                    changed = (moved > 0);
+                    if (changed) {
+                        my_location = 1 - my_location;
                     }
                 }
-            } else if (strcmp(policy, "dynamic") == 0) {
-                #pragma omp for schedule(dynamic)
-                for (int i = (phase % 2); i < n - 1; i += 2) {
-                    if (array[i] > array[i + 1]) {
-                        swap_values(&array[i], &array[i + 1]);
-                    }
+            }
+            location_next[tid] = (unsigned char)my_location;
+            round_changed[(round % 3) * block_count + tid] = (unsigned char)changed;
+
+            double round_barrier_start = tracing ? trace_now_us() : 0.0;
+            #pragma omp barrier
+            if (tracing) {
+                trace_record(tid, TRACE_MERGE, round, merge_start, round_barrier_start, 0.0, merge_steps, moved, 0);
+                trace_record(tid, TRACE_BARRIER, round, round_barrier_start, trace_now_us(), 0.0, 0, 0, 0);
+            }
+
+            if (uniform_blocks && round + 1 >= block_count) {
+                break;
+            }
+            // Duas rodadas consecutivas sem alterações cobrem todas as fronteiras: array ordenado
+            int any_change = (round == 0);
+            for (int t = 0; t < block_count && !any_change; ++t) {
+                any_change = round_changed[(round % 3) * block_count + t] |
+                             round_changed[((round + 2) % 3) * block_count + t];
+            }
+            if (!any_change) {
+                break;
+            }
+        }
+
+        // Traz de volta para o array o bloco que terminou no buffer auxiliar
+        if (my_location == 1) {
+            memcpy(array + my_start, scratch + my_start, my_size * sizeof(int));
+        }
+        trace_perf_end(tid);
+    }
+
+    free(scratch);
+    free(round_changed);
+    free(block_location);
+}
+
+// Odd-Even com ladrilhamento temporal em trapézios, paralelo sobre os ladrilhos.
+// As fases são agrupadas em blocos de 'phase_depth' fases. Em cada bloco, os pares são divididos em
+// ladrilhos de pelo menos 'tile_width' pares e cada thread aplica todas as fases do bloco a um
+// trapézio que encolhe uma posição de cada lado por fase (independente dos vizinhos). Em seguida,
+// os trapézios invertidos em torno de cada fronteira completam as comparações restantes. Cada
+// elemento recebe as mesmas comparações, na mesma ordem, que na versão sem ladrilhos; há apenas
+// duas barreiras por bloco de fases em vez de uma por fase.
+void tiled_parallel_odd_even_sort(int array[], int n, int num_threads, int tile_width, int phase_depth) {
+    compare_exchange_kernel_fn phase_kernel = trace_instrument_kernel(select_compare_exchange_kernel());
+    int tracing = trace_enabled();
+    long pair_count = n - 1;
+    // O último ladrilho absorve o resto, de modo que todos têm pelo menos 'tile_width' pares
+    long tile_count = (pair_count / tile_width > 0) ? pair_count / tile_width : 1;
+    long narrowest_tile = (tile_count == 1) ? pair_count : tile_width;
+    // Os trapézios exigem largura >= 2 * profundidade para não se sobreporem
+    if (phase_depth > narrowest_tile / 2) phase_depth = (int)(narrowest_tile / 2);
+    if (phase_depth < 1) phase_depth = 1;
+
+    #pragma omp parallel num_threads(num_threads)
+    {
+        int thread_id = omp_get_thread_num();
+        trace_perf_begin(thread_id);
+        for (int block_first_phase = 0; block_first_phase < n; block_first_phase += phase_depth) {
+            int block_depth = (n - block_first_phase < phase_depth) ? n - block_first_phase : phase_depth;
+            double trapezoid_start = tracing ? trace_now_us() : 0.0;
+
+            // Trapézios: o ladrilho perde um par de cada lado a cada fase
+            #pragma omp for schedule(static) nowait
+            for (long tile = 0; tile < tile_count; ++tile) {
+                long tile_start = tile * tile_width;
+                long tile_end = (tile == tile_count - 1) ? pair_count : tile_start + tile_width;
+                for (int depth = 0; depth < block_depth; ++depth) {
+                    apply_phase_to_range(phase_kernel, array, n, block_first_phase + depth,
+                                         tile_start + depth, tile_end - depth);
                 }
-            } else if (strcmp(policy, "guided") == 0) {
-                #pragma omp for schedule(guided)
-                for (int i = (phase % 2); i < n - 1; i += 2) {
-                    if (array[i] > array[i + 1]) {
-                        swap_values(&array[i], &array[i + 1]);
-                    }
+            }
+            double barrier_start = tracing ? trace_now_us() : 0.0;
+            #pragma omp barrier
+            if (tracing) {
+                trace_record_kernel_phase(thread_id, block_first_phase, trapezoid_start, barrier_start);
+                trace_record(thread_id, TRACE_BARRIER, block_first_phase, barrier_start, trace_now_us(), 0.0, 0, 0, 0);
+            }
+            double inverted_start = tracing ? trace_now_us() : 0.0;
+
+            // Trapézios invertidos: ganham um par de cada lado da fronteira a cada fase
+            #pragma omp for schedule(static) nowait
+            for (long boundary_idx = 0; boundary_idx <= tile_count; ++boundary_idx) {
+                long boundary = (boundary_idx == tile_count) ? pair_count : boundary_idx * tile_width;
+                for (int depth = 1; depth < block_depth; ++depth) {
+                    apply_phase_to_range(phase_kernel, array, n, block_first_phase + depth,
+                                         boundary - depth, boundary + depth);
+                }
+            }
+            barrier_start = tracing ? trace_now_us() : 0.0;
+            #pragma omp barrier
+            if (tracing) {
+                trace_record_kernel_phase(thread_id, block_first_phase, inverted_start, barrier_start);
+                trace_record(thread_id, TRACE_BARRIER, block_first_phase, barrier_start, trace_now_us(), 0.0, 0, 0, 0);
+            }
+        }
+        trace_perf_end(thread_id);
+    }
+}
+
+// Modo 'fluxo': tenta avançar uma fase em cada pedaço de [first_chunk, end_chunk) que esteja pronto.
+// O pedaço c (elementos [c * chunk_elements, (c + 1) * chunk_elements)) pode aplicar a fase p assim
+// que ele e os vizinhos c-1 e c+1 concluíram a fase p-1; nas fases ímpares ele também compara o par
+// que cruza sua fronteira esquerda. Um compare-and-swap em 'chunk_busy' impede que duas threads
+// avancem o mesmo pedaço. Retorna quantas fases foram aplicadas.
+int dataflow_advance_chunks(int array[], int n, compare_exchange_kernel_fn phase_kernel, int chunk_elements,
+                            int phases_done[], unsigned char chunk_busy[], int *finished_chunks,
+                            int first_chunk, int end_chunk, int thread_id, int tracing) {
+    int steps = 0;
+    for (int chunk = first_chunk; chunk < end_chunk; ++chunk) {
+        int *done = phases_done + chunk + 1; // phases_done[0] e phases_done[chunk_count + 1] são sentinelas
+        int phase = __atomic_load_n(done, __ATOMIC_ACQUIRE);
+        if (phase >= n || __atomic_load_n(done - 1, __ATOMIC_ACQUIRE) < phase ||
+            __atomic_load_n(done + 1, __ATOMIC_ACQUIRE) < phase) {
+            continue;
+        }
+        unsigned char expected = 0;
+        if (!__atomic_compare_exchange_n(&chunk_busy[chunk], &expected, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            continue;
+        }
+        // Outra thread pode ter avançado o pedaço entre a leitura e a reserva
+        if (__atomic_load_n(done, __ATOMIC_ACQUIRE) == phase) {
+            double phase_start = tracing ? trace_now_us() : 0.0;
+            apply_phase_to_range(phase_kernel, array, n, phase, (long)chunk * chunk_elements - (phase % 2),
+                                 (long)(chunk + 1) * chunk_elements - 1);
+            if (tracing) {
+                trace_record_kernel_phase(thread_id, phase, phase_start, trace_now_us());
+            }
+            __atomic_store_n(done, phase + 1, __ATOMIC_RELEASE);
+            if (phase + 1 == n) {
+                __atomic_fetch_add(finished_chunks, 1, __ATOMIC_RELEASE);
+            }
+            steps++;
+        }
+        __atomic_store_n(&chunk_busy[chunk], 0, __ATOMIC_RELEASE);
+    }
+    return steps;
+}
+
+// Odd-Even em fluxo de dados (frente de onda), sem barreira global por fase.
+// O pedaço c na fase p depende apenas dos pedaços c-1, c e c+1 na fase p-1, então cada pedaço guarda
+// um contador atômico de fases concluídas e avança assim que os vizinhos permitem: as fases se
+// propagam pelo array como uma frente de onda e pedaços distantes podem estar em fases diferentes.
+// Cada thread percorre primeiro os pedaços da sua faixa (localidade de cache) e, quando nenhum deles
+// está pronto, rouba trabalho de qualquer pedaço pronto do array. As comparações de cada elemento são
+// as mesmas, na mesma ordem, da versão com barreiras, logo o resultado é idêntico.
+void dataflow_odd_even_sort(int array[], int n, int num_threads, int pairs_per_chunk) {
+    compare_exchange_kernel_fn phase_kernel = trace_instrument_kernel(select_compare_exchange_kernel());
+    int tracing = trace_enabled();
+    int chunk_elements = 2 * pairs_per_chunk; // Par: as fases pares nunca cruzam pedaços
+    int chunk_count = (int)(((long)n + chunk_elements - 1) / chunk_elements);
+    int *phases_done = (int *)calloc(chunk_count + 2, sizeof(int));
+    unsigned char *chunk_busy = (unsigned char *)calloc(chunk_count, sizeof(unsigned char));
+    if (phases_done == NULL || chunk_busy == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o modo fluxo.\n");
+        exit(EXIT_FAILURE);
+    }
+    // Sentinelas: vizinhos fictícios das pontas já "concluíram" todas as fases
+    phases_done[0] = n;
+    phases_done[chunk_count + 1] = n;
+    int finished_chunks = 0;
+    if (num_threads > chunk_count) num_threads = chunk_count;
+
+    #pragma omp parallel num_threads(num_threads)
+    {
+        int thread_id = omp_get_thread_num();
+        int thread_total = omp_get_num_threads();
+        int home_first = (int)((long)chunk_count * thread_id / thread_total);
+        int home_end = (int)((long)chunk_count * (thread_id + 1) / thread_total);
+        double idle_start = -1.0; // Início da espera atual por vizinhos (instrumentação)
+        trace_perf_begin(thread_id);
+
+        while (__atomic_load_n(&finished_chunks, __ATOMIC_ACQUIRE) < chunk_count) {
+            int steps = dataflow_advance_chunks(array, n, phase_kernel, chunk_elements, phases_done, chunk_busy,
+                                                &finished_chunks, home_first, home_end, thread_id, tracing);
+            // Roubo: percorre o restante do array a partir do fim da própria faixa, para que threads
+            // diferentes não disputem sempre os mesmos pedaços
+            if (steps == 0) {
+                steps = dataflow_advance_chunks(array, n, phase_kernel, chunk_elements, phases_done, chunk_busy,
+                                                &finished_chunks, home_end, chunk_count, thread_id, tracing);
+            }
+            if (steps == 0) {
+                steps = dataflow_advance_chunks(array, n, phase_kernel, chunk_elements, phases_done, chunk_busy,
+                                                &finished_chunks, 0, home_first, thread_id, tracing);
+            }
+            if (tracing) {
+                // O tempo sem nenhum pedaço pronto corresponde à espera em barreira das outras políticas
+                if (steps == 0 && idle_start < 0.0) {
+                    idle_start = trace_now_us();
+                } else if (steps > 0 && idle_start >= 0.0) {
+                    trace_record(thread_id, TRACE_BARRIER, -1, idle_start, trace_now_us(), 0.0, 0, 0, 0);
+                    idle_start = -1.0;
                 }
             }
+            if (steps == 0) {
+                sched_yield(); // Nada pronto: cede o núcleo (importante com mais threads que núcleos)
+            }
+        }
+        if (tracing && idle_start >= 0.0) {
+            trace_record(thread_id, TRACE_BARRIER, -1, idle_start, trace_now_us(), 0.0, 0, 0, 0);
+        }
+        trace_perf_end(thread_id);
+    }
+
+    free(phases_done);
+    free(chunk_busy);
+}
+
+void parallel_odd_even_sort(int array[], int n, int num_threads, const char *policy) {
+    if (strcmp(policy, "bloco") == 0) {
+        block_odd_even_sort(array, n, num_threads);
+        return;
+    }
 
-            // Garante que todas as comparações da fase foram feitas
+    // A política é resolvida uma única vez e aplicada via schedule(runtime),
+    // evitando strcmp dentro de cada fase
+    omp_sched_t schedule_kind = omp_sched_static;
+    if (strcmp(policy, "dynamic") == 0) {
+        schedule_kind = omp_sched_dynamic;
+    } else if (strcmp(policy, "guided") == 0) {
+        schedule_kind = omp_sched_guided;
+    }
+    omp_set_schedule(schedule_kind, 0);
+    omp_set_num_threads(num_threads);
+    compare_exchange_kernel_fn phase_kernel = trace_instrument_kernel(select_compare_exchange_kernel());
+    int tracing = trace_enabled();
+
+    #pragma omp parallel
+    {
+        int thread_id = omp_get_thread_num();
+        trace_perf_begin(thread_id);
+        for (int phase = 0; phase < n; ++phase) {
+            double phase_start = tracing ? trace_now_us() : 0.0;
+            // Pares da fase: (i, i+1) com i = phase % 2, phase % 2 + 2, ...
+            int *phase_pairs = array + (phase % 2);
+            int pair_count = (n - (phase % 2)) / 2;
+            int chunk_count = (pair_count + PAIRS_PER_CHUNK - 1) / PAIRS_PER_CHUNK;
+
+            // Cada iteração aplica o kernel a um bloco de pares; a barreira explícita após o
+            // 'omp for' garante que a fase terminou (e permite medir a espera de cada thread)
+            #pragma omp for schedule(runtime) nowait
+            for (int chunk = 0; chunk < chunk_count; ++chunk) {
+                int first_pair = chunk * PAIRS_PER_CHUNK;
+                int chunk_pairs = (pair_count - first_pair < PAIRS_PER_CHUNK) ? pair_count - first_pair
+                                                                              : PAIRS_PER_CHUNK;
+                phase_kernel(phase_pairs + 2 * first_pair, chunk_pairs);
+            }
+            double barrier_start = tracing ? trace_now_us() : 0.0;
             #pragma omp barrier
-            #pragma omp flush(array)
+            if (tracing) {
+                trace_record_kernel_phase(thread_id, phase, phase_start, barrier_start);
+                trace_record(thread_id, TRACE_BARRIER, phase, barrier_start, trace_now_us(), 0.0, 0, 0, 0);
+            }
+        }
+        trace_perf_end(thread_id);
+    }
+}
+
+
+
+// Versões tipadas (ODD_EVEN_KEY / ODD_EVEN_PAYLOAD), geradas para cada elemento de odd_even_keys.h:
+// - fases com schedule(runtime) (políticas static, dynamic e guided), como parallel_odd_even_sort;
+// - 'bloco': cada thread ordena seu bloco com sort_<tipo> e faz merge-split com o vizinho. Os blocos
+//   alternam entre dois buffers a cada rodada (quem fica sem vizinho copia o bloco), e a ordenação
+//   termina após 'block_count' rodadas com blocos iguais ou após duas rodadas sem alterações.
+#define DEFINE_TYPED_OPENMP_SORTS(suffix, element_type)                                                \
+void typed_parallel_odd_even_sort_##suffix(element_type array[], long n, int num_threads) {           \
+    _Pragma("omp parallel num_threads(num_threads)")                                                   \
+    for (long phase = 0; phase < n; ++phase) {                                                         \
+        element_type *phase_pairs = array + (phase % 2);                                               \
+        long pair_count = (n - (phase % 2)) / 2;                                                       \
+        long chunk_count = (pair_count + PAIRS_PER_CHUNK - 1) / PAIRS_PER_CHUNK;                       \
+        _Pragma("omp for schedule(runtime)")                                                           \
+        for (long chunk = 0; chunk < chunk_count; ++chunk) {                                           \
+            long first_pair = chunk * PAIRS_PER_CHUNK;                                                 \
+            long chunk_pairs = (pair_count - first_pair < PAIRS_PER_CHUNK) ? pair_count - first_pair   \
+                                                                           : PAIRS_PER_CHUNK;          \
+            compare_exchange_pairs_##suffix(phase_pairs + 2 * first_pair, chunk_pairs);                \
+        }                                                                                              \
+    }                                                                                                  \
+}                                                                                                      \
+                                                                                                       \
+void typed_block_odd_even_sort_##suffix(element_type array[], long n, int num_threads) {              \
+    int block_count = (num_threads < n) ? num_threads : (int)n;                                        \
+    element_type *scratch = (element_type *)malloc(n * sizeof(element_type));                          \
+    if (scratch == NULL) {                                                                             \
+        fprintf(stderr, "Erro ao alocar memória para o modo por blocos.\n");                          \
+        exit(EXIT_FAILURE);                                                                            \
+    }                                                                                                  \
+    element_type *buffers[2] = { array, scratch };                                                     \
+    long round_changes[4] = { 0, 0, 0, 0 }; /* Anel: a rodada r soma em r % 4 */                       \
+    int uniform_blocks = (n % block_count == 0);                                                       \
+    int final_buffer = 0;                                                                              \
+                                                                                                       \
+    _Pragma("omp parallel num_threads(block_count)")                                                   \
+    {                                                                                                  \
+        int tid = omp_get_thread_num();                                                                \
+        long my_start = n * tid / block_count;                                                         \
+        long my_size = n * (tid + 1) / block_count - my_start;                                         \
+        sort_##suffix(array + my_start, my_size);                                                      \
+        _Pragma("omp barrier")                                                                         \
+        for (int round = 0; block_count > 1; ++round) {                                                \
+            const element_type *current = buffers[round % 2];                                          \
+            element_type *next = buffers[(round + 1) % 2];                                             \
+            int partner = (round % 2 == tid % 2) ? tid + 1 : tid - 1;                                  \
+            long moved = 0;                                                                            \
+            if (partner >= 0 && partner < block_count) {                                               \
+                long partner_start = n * partner / block_count;                                        \
+                long partner_size = n * (partner + 1) / block_count - partner_start;                   \
+                moved = merge_split_##suffix(current + my_start, my_size, current + partner_start,     \
+                                             partner_size, next + my_start, tid < partner);            \
+            } else {                                                                                   \
+                memcpy(next + my_start, current + my_start, my_size * sizeof(element_type));           \
+            }                                                                                          \
+            if (moved > 0) {                                                                           \
+                _Pragma("omp atomic")                                                                  \
+                round_changes[round % 4] += moved;                                                     \
+            }                                                                                          \
+            /* A posição lida duas rodadas atrás já pode ser zerada para a próxima rodada */           \
+            if (tid == 0) round_changes[(round + 1) % 4] = 0;                                          \
+            _Pragma("omp barrier")                                                                     \
+            int finished = (uniform_blocks && round + 1 >= block_count) ||                             \
+                           (round > 0 && round_changes[round % 4] == 0 &&                              \
+                            round_changes[(round + 3) % 4] == 0);                                      \
+            if (finished) {                                                                            \
+                if (tid == 0) final_buffer = (round + 1) % 2;                                          \
+                break;                                                                                 \
+            }                                                                                          \
+        }                                                                                              \
+    }                                                                                                  \
+    if (final_buffer == 1) {                                                                           \
+        memcpy(array, scratch, n * sizeof(element_type));                                              \
+    }                                                                                                  \
+    free(scratch);                                                                                     \
+}                                                                                                      \
+                                                                                                       \
+int run_typed_openmp_##suffix(long n, int num_threads, const char *policy, const input_config *input_settings, \
+                              const char *type_text) {                                                 \
+    element_type *typed_array = (element_type *)malloc(n * sizeof(element_type));                      \
+    if (typed_array == NULL) {                                                                         \
+        fprintf(stderr, "Erro ao alocar memória.\n");                                                  \
+        return EXIT_FAILURE;                                                                           \
+    }                                                                                                  \
+    /* Geração paralela por contador: o resultado não depende do número de threads */                 \
+    long fill_chunks = (n + INPUT_PARALLEL_MIN_ITEMS - 1) / INPUT_PARALLEL_MIN_ITEMS;                  \
+    _Pragma("omp parallel for schedule(static) num_threads(num_threads)")                              \
+    for (long chunk = 0; chunk < fill_chunks; ++chunk) {                                               \
+        long first = chunk * INPUT_PARALLEL_MIN_ITEMS;                                                 \
+        long count = (n - first < INPUT_PARALLEL_MIN_ITEMS) ? n - first : INPUT_PARALLEL_MIN_ITEMS;    \
+        fill_range_##suffix(typed_array + first, first, count, n, input_settings);                     \
+    }                                                                                                  \
+    report_input_config(input_settings, stderr);                                                       \
+    fprintf(stderr, "Array original (segmento): ");                                                   \
+    display_segment_##suffix(typed_array, n, stderr);                                                 \
+    omp_set_num_threads(num_threads); /* Equipe das verificações paralelas */                          \
+    uint64_t input_checksum[MULTISET_CHECKSUM_WORDS], output_checksum[MULTISET_CHECKSUM_WORDS];        \
+    multiset_checksum_clear(input_checksum);                                                           \
+    multiset_checksum_##suffix(typed_array, n, input_checksum);                                        \
+                                                                                                       \
+    double start_time_stamp = omp_get_wtime();                                                         \
+    if (strcmp(policy, "bloco") == 0) {                                                                \
+        typed_block_odd_even_sort_##suffix(typed_array, n, num_threads);                               \
+    } else {                                                                                           \
+        omp_set_schedule(strcmp(policy, "dynamic") == 0  ? omp_sched_dynamic                           \
+                         : strcmp(policy, "guided") == 0 ? omp_sched_guided                            \
+                                                         : omp_sched_static, 0);                       \
+        typed_parallel_odd_even_sort_##suffix(typed_array, n, num_threads);                            \
+    }                                                                                                  \
+    double end_time_stamp = omp_get_wtime();                                                           \
+                                                                                                       \
+    fprintf(stdout, "Tempo de execução OpenMP (%d threads, política %s, %s): %.6f segundos\n",        \
+            num_threads, policy, type_text, end_time_stamp - start_time_stamp);                        \
+    fprintf(stderr, "Array ordenado (segmento): ");                                                   \
+    display_segment_##suffix(typed_array, n, stderr);                                                  \
+    double verify_start = omp_get_wtime();                                                             \
+    int in_order = verify_sorted_##suffix(typed_array, n);                                             \
+    multiset_checksum_clear(output_checksum);                                                          \
+    multiset_checksum_##suffix(typed_array, n, output_checksum);                                       \
+    int is_permutation = multiset_checksums_equal(input_checksum, output_checksum);                    \
+    report_verification(stdout, in_order, is_permutation, omp_get_wtime() - verify_start);             \
+    fprintf(stdout, "Status de ordenação: %s\n", (in_order && is_permutation) ? "Ordenado" : "Não Ordenado"); \
+    free(typed_array);                                                                                 \
+    return (in_order && is_permutation) ? EXIT_SUCCESS : EXIT_FAILURE;                                 \
+}
+
+#define DEFINE_TYPED_OPENMP_SORT_PAIR(name, type)                                                      \
+    DEFINE_TYPED_OPENMP_SORTS(name, type)                                                              \
+    DEFINE_TYPED_OPENMP_SORTS(record_##name, record_##name)
+
+ODD_EVEN_KEY_TYPES(DEFINE_TYPED_OPENMP_SORT_PAIR)
+
+// Despacha para a versão especializada do tipo configurado
+int run_typed_openmp(const key_config *key_settings, long n, int num_threads, const char *policy,
+                     const input_config *input_settings) {
+    char type_text[32];
+    describe_key_config(key_settings, type_text, sizeof(type_text));
+    switch (key_settings->type) {
+#define TYPED_OPENMP_CASE(name, type)                                                                  \
+    case KEY_TYPE_##name:                                                                              \
+        return key_settings->with_payload                                                              \
+                   ? run_typed_openmp_record_##name(n, num_threads, policy, input_settings, type_text) \
+                   : run_typed_openmp_##name(n, num_threads, policy, input_settings, type_text);
+        ODD_EVEN_KEY_TYPES(TYPED_OPENMP_CASE)
+#undef TYPED_OPENMP_CASE
+    default:
+        return EXIT_FAILURE;
+    }
+}
+
+// Modo lote: gera 'batch_count' arrays independentes com tamanhos entre 8 e 'max_keys' (log-uniformes:
+// cada faixa de potência de 2 recebe a mesma fração dos arrays, como em cargas dominadas por arrays
+// pequenos), e os ordena 'calls' vezes com odd_even_sort_batch dentro de UMA região paralela, de modo
+// que a mesma equipe de threads atende a todas as chamadas. Como a rede não depende dos dados, as
+// chamadas seguintes à primeira (sobre arrays já ordenados) custam o mesmo.
+int run_batch_mode(int batch_count, int thread_count, int max_keys, int calls) {
+    input_config input_settings;
+    if (!read_input_config(&input_settings)) {
+        return EXIT_FAILURE;
+    }
+    long *offsets = (long *)malloc((batch_count + 1) * sizeof(long));
+    if (offsets == NULL) {
+        fprintf(stderr, "Erro ao alocar memória.\n");
+        return EXIT_FAILURE;
+    }
+    int min_keys = (max_keys < 8) ? 1 : 8;
+    int top_bucket = 0;
+    while ((min_keys << top_bucket) < max_keys) top_bucket++;
+    uint64_t size_state = input_settings.seed ^ 0x5851F42D4C957F2DULL; // Tamanhos independentes das chaves
+    offsets[0] = 0;
+    for (int array_idx = 0; array_idx < batch_count; ++array_idx) {
+        int bucket = (int)(splitmix64_next(&size_state) % (uint64_t)(top_bucket + 1));
+        long bucket_high = (long)min_keys << bucket;
+        if (bucket_high > max_keys) bucket_high = max_keys;
+        long bucket_low = (bucket == 0) ? min_keys : ((long)min_keys << (bucket - 1)) + 1;
+        offsets[array_idx + 1] = offsets[array_idx] + bucket_low +
+                                 (long)(splitmix64_next(&size_state) % (uint64_t)(bucket_high - bucket_low + 1));
+    }
+    long total_keys = offsets[batch_count];
+    if (total_keys > INT_MAX) {
+        fprintf(stderr, "Erro: o lote excede %d chaves.\n", INT_MAX);
+        free(offsets);
+        return EXIT_FAILURE;
+    }
+    int *keys = (int *)malloc(total_keys * sizeof(int));
+    if (keys == NULL) {
+        fprintf(stderr, "Erro ao alocar memória.\n");
+        free(offsets);
+        return EXIT_FAILURE;
+    }
+    fill_input_array(keys, (int)total_keys, &input_settings);
+    report_input_config(&input_settings, stderr);
+    uint64_t input_checksum[MULTISET_CHECKSUM_WORDS], output_checksum[MULTISET_CHECKSUM_WORDS];
+    multiset_checksum_clear(input_checksum);
+    batch_verification_pass(keys, offsets, batch_count, thread_count, input_checksum, NULL);
+    int lane_arrays = 0;
+    for (int array_idx = 0; array_idx < batch_count; ++array_idx) {
+        lane_arrays += (offsets[array_idx + 1] - offsets[array_idx] <= BATCH_LANE_MAX_KEYS);
+    }
+    fprintf(stderr, "Lote: %d arrays (%d em lanes SIMD), %ld chaves, até %d chaves por array\n",
+            batch_count, lane_arrays, total_keys, max_keys);
+    int tracing = trace_enabled();
+
+    double start_time_stamp = omp_get_wtime();
+    #pragma omp parallel num_threads(thread_count)
+    {
+        int thread_id = omp_get_thread_num();
+        trace_perf_begin(thread_id);
+        for (int call = 0; call < calls; ++call) {
+            double call_start = tracing ? trace_now_us() : 0.0;
+            odd_even_sort_batch(keys, offsets, batch_count);
+            if (tracing) {
+                trace_record(thread_id, TRACE_LOCAL_SORT, call, call_start, trace_now_us(), 0.0, 0, 0, 0);
+            }
         }
+        trace_perf_end(thread_id);
     }
+    double elapsed = omp_get_wtime() - start_time_stamp;
+
+    double verify_start = omp_get_wtime();
+    long disordered_arrays = 0;
+    multiset_checksum_clear(output_checksum);
+    batch_verification_pass(keys, offsets, batch_count, thread_count, output_checksum, &disordered_arrays);
+    int is_permutation = multiset_checksums_equal(input_checksum, output_checksum);
+    int all_sorted = (disordered_arrays == 0) && is_permutation;
+    double verify_seconds = omp_get_wtime() - verify_start;
+    fprintf(stdout, "Tempo de execução OpenMP (lote, %d threads, %d chamadas): %.6f segundos\n",
+            thread_count, calls, elapsed);
+    fprintf(stdout, "Vazão: %.0f arrays/s (%.3f us por chamada de %d arrays)\n",
+            (double)batch_count * calls / elapsed, elapsed * 1e6 / calls, batch_count);
+    report_verification(stdout, disordered_arrays == 0, is_permutation, verify_seconds);
+    fprintf(stdout, "Status de ordenação: %s\n", all_sorted ? "Ordenado" : "Não Ordenado");
+    trace_finish("odd_even_openmp", "thread");
+
+    free(keys);
+    free(offsets);
+    return all_sorted ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
+// Modo incremental: ordena 'initial_size' chaves e depois absorve 'update_count' lotes de 'batch_size'
+// chaves com incremental_append, medindo apenas as atualizações. As chaves seguem o gerador por
+// contador (posições consecutivas da mesma entrada), então a distribuição 'ordenado' simula um fluxo
+// crescente e 'uniforme' um fluxo em que cada lote atinge quase todo o prefixo.
+int run_incremental_mode(long initial_size, long batch_size, int update_count, int thread_count) {
+    input_config input_settings;
+    if (!read_input_config(&input_settings)) {
+        return EXIT_FAILURE;
+    }
+    long total_items = initial_size + batch_size * update_count;
+    long largest_input = (initial_size > batch_size) ? initial_size : batch_size;
+    int *incoming = (int *)malloc((size_t)largest_input * sizeof(int));
+    incremental_sorted_array sorted;
+    incremental_init(&sorted);
+    if (incoming == NULL) {
+        fprintf(stderr, "Erro ao alocar memória.\n");
+        return EXIT_FAILURE;
+    }
+    report_input_config(&input_settings, stderr);
+    omp_set_num_threads(thread_count); // Equipe da geração e das verificações paralelas
+
+    // Todas as chaves que entram no array, para a verificação de permutação no fim
+    uint64_t input_checksum[MULTISET_CHECKSUM_WORDS], output_checksum[MULTISET_CHECKSUM_WORDS];
+    multiset_checksum_clear(input_checksum);
+    fill_input_range(incoming, 0, initial_size, total_items, &input_settings);
+    multiset_checksum_int(incoming, initial_size, input_checksum);
+    double initial_start = omp_get_wtime();
+    int appended = incremental_append(&sorted, incoming, initial_size, thread_count);
+    double initial_elapsed = omp_get_wtime() - initial_start;
+
+    double update_elapsed = 0.0;
+    for (int update = 0; update < update_count && appended; ++update) {
+        fill_input_range(incoming, initial_size + batch_size * update, batch_size, total_items, &input_settings);
+        multiset_checksum_int(incoming, batch_size, input_checksum);
+        double update_start = omp_get_wtime();
+        appended = incremental_append(&sorted, incoming, batch_size, thread_count);
+        update_elapsed += omp_get_wtime() - update_start;
+    }
+    if (!appended) {
+        fprintf(stderr, "Erro ao alocar memória.\n");
+        incremental_free(&sorted);
+        free(incoming);
+        return EXIT_FAILURE;
+    }
+
+    fprintf(stdout, "Tempo de execução OpenMP (incremental, %d threads, %d lotes de %ld chaves): %.6f segundos\n",
+            thread_count, update_count, batch_size, update_elapsed);
+    fprintf(stdout, "Ordenação inicial de %ld chaves: %.6f segundos\n", initial_size, initial_elapsed);
+    if (update_count > 0) {
+        fprintf(stdout, "Por lote: %.6f segundos, %.0f chaves do prefixo regravadas em média (array final com %ld chaves)\n",
+                update_elapsed / update_count, (double)sorted.moved_elements / update_count, sorted.size);
+    }
+    fprintf(stderr, "Array ordenado (segmento): ");
+    display_array_segment(sorted.data, (int)((sorted.size < 21) ? sorted.size : 21), stderr);
+
+    double verify_start = omp_get_wtime();
+    int in_order = verify_sorted_int(sorted.data, sorted.size);
+    multiset_checksum_clear(output_checksum);
+    multiset_checksum_int(sorted.data, sorted.size, output_checksum);
+    int is_permutation = multiset_checksums_equal(input_checksum, output_checksum);
+    report_verification(stdout, in_order, is_permutation, omp_get_wtime() - verify_start);
+    fprintf(stdout, "Status de ordenação: %s\n", (in_order && is_permutation) ? "Ordenado" : "Não Ordenado");
+    trace_finish("odd_even_openmp", "thread");
 
+    incremental_free(&sorted);
+    free(incoming);
+    return (in_order && is_permutation) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
 
 int main(int argc, char *argv[]) {
-    if (argc != 4) {
-        fprintf(stderr, "Uso correto: %s <tamanho_do_array> <numero_de_threads> <politica: static|dynamic|guided>\n", argv[0]);
+    trace_init();
+
+    // Modo incremental: array ordenado que absorve lotes anexados ao fim
+    if (argc >= 2 && strcmp(argv[1], "-i") == 0) {
+        if (argc != 6) {
+            fprintf(stderr, "Uso correto: %s -i <tamanho_inicial> <tamanho_do_lote> <lotes> <numero_de_threads>\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+        long initial_size = atol(argv[2]);
+        long batch_size = atol(argv[3]);
+        int update_count = atoi(argv[4]);
+        int incremental_threads = atoi(argv[5]);
+        if (initial_size < 0 || batch_size <= 0 || update_count < 0 || incremental_threads <= 0) {
+            fprintf(stderr, "Erro: tamanho do lote e threads devem ser positivos; tamanho inicial e lotes, não negativos.\n");
+            return EXIT_FAILURE;
+        }
+        return run_incremental_mode(initial_size, batch_size, update_count, incremental_threads);
+    }
+
+    // Modo lote: muitos arrays pequenos e independentes ordenados por chamada
+    if (argc >= 2 && strcmp(argv[1], "-l") == 0) {
+        if (argc < 4 || argc > 6) {
+            fprintf(stderr, "Uso correto: %s -l <quantidade_de_arrays> <numero_de_threads> [tamanho_max] [chamadas]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+        int batch_count = atoi(argv[2]);
+        int batch_threads = atoi(argv[3]);
+        int max_keys = (argc >= 5) ? atoi(argv[4]) : 1024;
+        int calls = (argc >= 6) ? atoi(argv[5]) : 1;
+        if (batch_count <= 0 || batch_threads <= 0 || max_keys <= 0 || calls <= 0) {
+            fprintf(stderr, "Erro: quantidade de arrays, threads, tamanho máximo e chamadas devem ser positivos.\n");
+            return EXIT_FAILURE;
+        }
+        return run_batch_mode(batch_count, batch_threads, max_keys, calls);
+    }
+
+    // Modo automático: threads, política e larguras vêm do perfil calibrado desta máquina
+    int auto_mode = (argc == 3 && strcmp(argv[2], "auto") == 0);
+    if (!auto_mode && (argc < 4 || argc > 6)) {
+        fprintf(stderr, "Uso correto: %s <tamanho_do_array> <numero_de_threads> <politica: static|dynamic|guided|bloco|ladrilhado|fluxo> [largura_ladrilho] [profundidade]\n", argv[0]);
+        fprintf(stderr, "             %s <tamanho_do_array> auto   (perfil gerado por 'python3 autotune.py calibrar')\n", argv[0]);
         return EXIT_FAILURE;
     }
 
     int array_size = atoi(argv[1]);
-    int thread_count = atoi(argv[2]);
-    const char *schedule_policy = argv[3];
+    tune_entry tuned = { 0, "openmp", 0, "static", 0, 0, 0.0 };
+    if (auto_mode && array_size > 0) {
+        char profile_path[512];
+        tune_profile_path(profile_path, sizeof(profile_path));
+        if (tune_lookup(profile_path, "openmp", array_size, &tuned)) {
+            fprintf(stdout, "Configuração automática: %d threads, política %s (perfil %s, calibrado para %ld elementos)\n",
+                    tuned.workers, tuned.policy, profile_path, tuned.size);
+        } else {
+            tuned.workers = omp_get_num_procs();
+            fprintf(stderr, "Aviso: perfil '%s' ausente ou sem configuração OpenMP; usando %d threads e política static. "
+                            "Rode 'python3 autotune.py calibrar' para gerá-lo.\n", profile_path, tuned.workers);
+        }
+    }
+    int thread_count = auto_mode ? tuned.workers : atoi(argv[2]);
+    const char *schedule_policy = auto_mode ? tuned.policy : argv[3];
+    // Parâmetros do modo ladrilhado: largura do ladrilho (em pares) e fases por bloco.
+    // No modo fluxo, a largura é o número de pares por pedaço (padrão PAIRS_PER_CHUNK).
+    int tile_width = (argc >= 5) ? atoi(argv[4]) : (strcmp(schedule_policy, "fluxo") == 0 ? PAIRS_PER_CHUNK : 16384);
+    int phase_depth = (argc >= 6) ? atoi(argv[5]) : 1024;
+    if (tuned.width > 0) tile_width = tuned.width;
+    if (tuned.depth > 0) phase_depth = tuned.depth;
 
     if (array_size <= 0 || thread_count <= 0) {
         fprintf(stderr, "Erro: tamanho do array e número de threads devem ser positivos.\n");
         return EXIT_FAILURE;
     }
 
-    if (!(strcmp(schedule_policy, "static") == 0 || strcmp(schedule_policy, "dynamic") == 0 || strcmp(schedule_policy, "guided") == 0)) {
-        fprintf(stderr, "Erro: política de escalonamento deve ser 'static', 'dynamic' ou 'guided'.\n");
+    if (!(strcmp(schedule_policy, "static") == 0 || strcmp(schedule_policy, "dynamic") == 0 ||
+          strcmp(schedule_policy, "guided") == 0 || strcmp(schedule_policy, "bloco") == 0 ||
+          strcmp(schedule_policy, "ladrilhado") == 0 || strcmp(schedule_policy, "fluxo") == 0)) {
+        fprintf(stderr, "Erro: política de escalonamento deve ser 'static', 'dynamic', 'guided', 'bloco', 'ladrilhado' ou 'fluxo'.\n");
         return EXIT_FAILURE;
     }
 
-    int *main_array = (int *)malloc(array_size * sizeof(int));
-    if (main_array == NULL) {
-        fprintf(stderr, "Erro ao alocar memória.\n");
+    if (tile_width <= 0 || phase_depth <= 0) {
+        fprintf(stderr, "Erro: largura do ladrilho e profundidade devem ser positivas.\n");
+        return EXIT_FAILURE;
+    }
+
+    input_config input_settings;
+    if (!read_input_config(&input_settings)) {
+        return EXIT_FAILURE;
+    }
+
+    // Tipo da chave (ODD_EVEN_KEY / ODD_EVEN_PAYLOAD); os demais tipos usam as políticas por fase e 'bloco'
+    key_config key_settings;
+    if (!read_key_config(&key_settings)) {
+        return EXIT_FAILURE;
+    }
+    if (!key_config_is_default(&key_settings)) {
+        // O perfil é calibrado com chaves int; as políticas exclusivas delas viram 'bloco'
+        if (auto_mode && (strcmp(schedule_policy, "ladrilhado") == 0 || strcmp(schedule_policy, "fluxo") == 0)) {
+            schedule_policy = "bloco";
+        }
+        if (strcmp(schedule_policy, "ladrilhado") == 0 || strcmp(schedule_policy, "fluxo") == 0) {
+            fprintf(stderr, "Erro: a política '%s' está disponível apenas para chaves int sem payload.\n",
+                    schedule_policy);
+            return EXIT_FAILURE;
+        }
+        int typed_status = run_typed_openmp(&key_settings, array_size, thread_count, schedule_policy, &input_settings);
+        trace_finish("odd_even_openmp", "thread");
+        return typed_status;
+    }
+
+    // Posicionamento de memória e threads (ODD_EVEN_PLACEMENT / ODD_EVEN_HUGEPAGES / ODD_EVEN_PIN)
+    numa_config memory_settings;
+    if (!read_numa_config(&memory_settings)) {
         return EXIT_FAILURE;
     }
+    pin_openmp_threads(memory_settings.pinning, thread_count);
 
-    fill_with_random_numbers(main_array, array_size, 1000);
+    sort_array array_storage;
+    if (!allocate_sort_array(&array_storage, array_size, memory_settings.huge_pages)) {
+        fprintf(stderr, "Erro ao alocar memória.\n");
+        return EXIT_FAILURE;
+    }
+    int *main_array = array_storage.data;
+    // Geração paralela da entrada: no primeiro toque, com a partição estática das fases (pedaços de
+    // PAIRS_PER_CHUNK pares); na alocação ingênua, a thread mestre toca todas as páginas antes
+    if (memory_settings.placement == PLACEMENT_FIRST_TOUCH) {
+        first_touch_fill_sort_array(main_array, array_size, 2L * PAIRS_PER_CHUNK, thread_count, &input_settings);
+    } else {
+        memset(main_array, 0, (size_t)array_size * sizeof(int));
+        fill_input_array(main_array, array_size, &input_settings);
+    }
+    report_input_config(&input_settings, stderr);
+    report_numa_topology(stderr, &memory_settings, &array_storage, thread_count);
 
     fprintf(stderr, "Array original (segmento): ");
     display_array_segment(main_array, array_size, stderr);
 
+    // Assinatura de multiconjunto da entrada (fora da medição), para a verificação de permutação;
+    // as verificações paralelas usam a mesma quantidade de threads da ordenação
+    omp_set_num_threads(thread_count);
+    uint64_t input_checksum[MULTISET_CHECKSUM_WORDS], output_checksum[MULTISET_CHECKSUM_WORDS];
+    multiset_checksum_clear(input_checksum);
+    multiset_checksum_int(main_array, array_size, input_checksum);
+
     double start_time_stamp = omp_get_wtime();
 
-    parallel_odd_even_sort(main_array, array_size, thread_count, schedule_policy);
+    if (strcmp(schedule_policy, "ladrilhado") == 0) {
+        tiled_parallel_odd_even_sort(main_array, array_size, thread_count, tile_width, phase_depth);
+    } else if (strcmp(schedule_policy, "fluxo") == 0) {
+        dataflow_odd_even_sort(main_array, array_size, thread_count, tile_width);
+    } else {
+        parallel_odd_even_sort(main_array, array_size, thread_count, schedule_policy);
+    }
 
     double end_time_stamp = omp_get_wtime();
 
     fprintf(stdout, "Tempo de execução OpenMP (%d threads, política %s): %.6f segundos\n",
             thread_count, schedule_policy, end_time_stamp - start_time_stamp);
+    if (strcmp(schedule_policy, "ladrilhado") == 0) {
+        fprintf(stdout, "Modo ladrilhado: largura %d pares, profundidade %d fases\n", tile_width, phase_depth);
+    } else if (strcmp(schedule_policy, "fluxo") == 0) {
+        fprintf(stdout, "Modo fluxo: %d pares por pedaço\n", tile_width);
+    }
 
     fprintf(stderr, "Array ordenado (segmento): ");
     display_array_segment(main_array, array_size, stderr);
 
-    fprintf(stdout, "Status de ordenação: %s\n", check_if_sorted(main_array, array_size) ? "Ordenado" : "Não Ordenado");
+    // Ordem e permutação da entrada, cada uma em uma passada paralela
+    double verify_start = omp_get_wtime();
+    int in_order = verify_sorted_int(main_array, array_size);
+    multiset_checksum_clear(output_checksum);
+    multiset_checksum_int(main_array, array_size, output_checksum);
+    int is_permutation = multiset_checksums_equal(input_checksum, output_checksum);
+    report_verification(stdout, in_order, is_permutation, omp_get_wtime() - verify_start);
+    fprintf(stdout, "Status de ordenação: %s\n", (in_order && is_permutation) ? "Ordenado" : "Não Ordenado");
+    trace_finish("odd_even_openmp", "thread");
 
-    free(main_array);
-    return EXIT_SUCCESS;
+    free_sort_array(&array_storage);
+    return (in_order && is_permutation) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -1,35 +1,61 @@
 #include <stdio.h>
 #include <stdlib.h> // Para malloc e EXIT_SUCCESS/EXIT_FAILURE
-#include <time.h>   // Para time() em srand
+#include <string.h> // Para strcmp
 #include <sys/time.h> // Para gettimeofday
-
-// Função para trocar os valores de duas variáveis inteiras
-void swap_values(int *first_val_ptr, int *second_val_ptr) {
-    int holding_value = *first_val_ptr;
-    *first_val_ptr = *second_val_ptr;
-    *second_val_ptr = holding_value;
-}
+#include <sys/mman.h> // Para mmap, madvise e msync (modo arquivo)
+#include <sys/stat.h> // Para fstat
+#include <fcntl.h>    // Para open
+#include <unistd.h>   // Para close
+#include "odd_even_kernel.h" // Kernel de compare-exchange (AVX2/SSE4.1/escalar)
+#include "odd_even_input.h"  // Entrada reprodutível (distribuição e semente)
+#include "odd_even_trace.h"  // Instrumentação opcional (ODD_EVEN_TRACE / ODD_EVEN_PERF)
+#include "odd_even_keys.h"   // Chaves tipadas e registros (ODD_EVEN_KEY / ODD_EVEN_PAYLOAD)
 
 // Implementa o algoritmo Odd-Even Transposition Sort de forma serial
+// Cada fase é aplicada pelo kernel de compare-exchange sem desvios (SIMD quando disponível)
 void perform_odd_even_sort_serial(int array_to_sort[], int num_elements) {
-    int current_sort_phase, element_index;
-    for (current_sort_phase = 0; current_sort_phase < num_elements; ++current_sort_phase) {
-        // Verifica se a fase atual é par
+    compare_exchange_kernel_fn phase_kernel = trace_instrument_kernel(select_compare_exchange_kernel());
+    int tracing = trace_enabled();
+    for (int current_sort_phase = 0; current_sort_phase < num_elements; ++current_sort_phase) {
+        double phase_start = tracing ? trace_now_us() : 0.0;
         if (current_sort_phase % 2 == 0) {
             // Fase Par: compara e troca elementos em posições (i-1, i) onde 'i' é ímpar
-            for (element_index = 1; element_index < num_elements; element_index += 2) {
-                if (array_to_sort[element_index - 1] > array_to_sort[element_index]) {
-                    swap_values(&array_to_sort[element_index - 1], &array_to_sort[element_index]);
-                }
-            }
+            phase_kernel(array_to_sort, num_elements / 2);
         } else {
             // Fase Ímpar: compara e troca elementos em posições (i, i+1) onde 'i' é ímpar
-            for (element_index = 1; element_index < num_elements - 1; element_index += 2) {
-                if (array_to_sort[element_index] > array_to_sort[element_index + 1]) {
-                    swap_values(&array_to_sort[element_index], &array_to_sort[element_index + 1]);
-                }
+            phase_kernel(array_to_sort + 1, (num_elements - 1) / 2);
+        }
+        if (tracing) {
+            trace_record_kernel_phase(0, current_sort_phase, phase_start, trace_now_us());
+        }
+    }
+}
+
+// Odd-Even Transposition Sort com ladrilhamento temporal (paralelogramos inclinados).
+// As fases são agrupadas em blocos de 'phase_depth' fases; para cada bloco, o array é percorrido
+// em ladrilhos de 'tile_width' pares e cada ladrilho recebe todas as fases do bloco enquanto está
+// em cache. Na fase d do bloco o ladrilho é deslocado d posições para a esquerda, de modo que
+// todo par só é comparado depois que seus vizinhos receberam a fase anterior: o conjunto e a
+// ordem das comparações por elemento são os mesmos da versão simples, logo o resultado é idêntico.
+void perform_odd_even_sort_serial_tiled(int array_to_sort[], int num_elements,
+                                        int tile_width, int phase_depth) {
+    compare_exchange_kernel_fn phase_kernel = trace_instrument_kernel(select_compare_exchange_kernel());
+    int tracing = trace_enabled();
+    for (int block_first_phase = 0; block_first_phase < num_elements; block_first_phase += phase_depth) {
+        int block_depth = (num_elements - block_first_phase < phase_depth) ? num_elements - block_first_phase
+                                                                          : phase_depth;
+        double block_start = tracing ? trace_now_us() : 0.0;
+        // O último ladrilho se estende além do fim para cobrir o deslocamento das fases
+        for (long tile_start = 0; tile_start < (long)num_elements - 1 + block_depth; tile_start += tile_width) {
+            for (int depth = 0; depth < block_depth; ++depth) {
+                apply_phase_to_range(phase_kernel, array_to_sort, num_elements, block_first_phase + depth,
+                                     tile_start - depth, tile_start + tile_width - depth);
             }
         }
+        // Um evento por bloco de fases (identificado pela primeira fase do bloco)
+        if (tracing) {
+            trace_record_kernel_phase(0, block_first_phase, block_start, trace_now_us());
+        }
     }
 }
 
@@ -47,38 +73,309 @@ void display_array_segment(int target_array[], int array_length, FILE *output_st
     }
 }
 
+// Intercala dois runs ordenados e contíguos [left | right] (split de blocos do odd-even): após a
+// chamada o run da esquerda guarda os menores elementos e o da direita os maiores, ambos ordenados.
+// Retorna 0 sem tocar nos dados se a fronteira já estiver em ordem.
+int merge_split_adjacent_runs(int runs[], int64_t left_size, int64_t right_size, int scratch[]) {
+    int *right_run = runs + left_size;
+    if (runs[left_size - 1] <= right_run[0]) {
+        return 0;
+    }
+    int64_t left_idx = 0, right_idx = 0, out_idx = 0;
+    while (left_idx < left_size && right_idx < right_size) {
+        scratch[out_idx++] = (right_run[right_idx] < runs[left_idx]) ? right_run[right_idx++] : runs[left_idx++];
+    }
+    while (left_idx < left_size) scratch[out_idx++] = runs[left_idx++];
+    while (right_idx < right_size) scratch[out_idx++] = right_run[right_idx++];
+    memcpy(runs, scratch, (size_t)(left_size + right_size) * sizeof(int));
+    return 1;
+}
+
+// Janela das dicas de madvise no modo arquivo: as páginas são pedidas/liberadas em trechos deste
+// tamanho (alinhados à página), e não a cada run, para não gastar uma chamada de sistema por par
+#define MADVISE_WINDOW_BYTES ((size_t)32 << 20)
 
-// Preenche um array com números inteiros aleatórios
-void fill_with_random_numbers(int dest_array[], int total_items, int max_possible_value) {
-    srand(time(NULL)); // Inicializa o gerador de números aleatórios com base no tempo atual
-    for (int i = 0; i < total_items; ++i) {
-        dest_array[i] = rand() % max_possible_value;
+// Avança a janela de leitura antecipada/descarte de uma passada sequencial pelo mapeamento: pede ao
+// kernel a próxima janela (MADV_WILLNEED) e libera as páginas já processadas antes de 'done_bytes'
+// (MADV_DONTNEED; em mapeamentos MAP_SHARED as páginas sujas continuam no page cache do arquivo).
+// Com 'done_bytes' igual ao tamanho do mapeamento, libera tudo o que falta.
+void advance_mapped_window(char *mapped_base, size_t mapped_bytes, size_t *released_bytes,
+                           size_t *prefetched_bytes, size_t done_bytes) {
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    size_t release_end = (done_bytes >= mapped_bytes) ? mapped_bytes : done_bytes / page_size * page_size;
+    if (release_end >= *released_bytes + MADVISE_WINDOW_BYTES || release_end == mapped_bytes) {
+        if (release_end > *released_bytes) {
+            madvise(mapped_base + *released_bytes, release_end - *released_bytes, MADV_DONTNEED);
+            *released_bytes = release_end;
+        }
+    }
+    if (done_bytes + MADVISE_WINDOW_BYTES / 2 >= *prefetched_bytes && *prefetched_bytes < mapped_bytes) {
+        size_t prefetch_start = (*prefetched_bytes > done_bytes) ? *prefetched_bytes : done_bytes / page_size * page_size;
+        size_t prefetch_end = prefetch_start + MADVISE_WINDOW_BYTES;
+        if (prefetch_end > mapped_bytes) prefetch_end = mapped_bytes;
+        madvise(mapped_base + prefetch_start, prefetch_end - prefetch_start, MADV_WILLNEED);
+        *prefetched_bytes = prefetch_end;
     }
 }
 
-// Verifica se os elementos de um array estão em ordem não decrescente
-int check_if_sorted(int data_array_ptr[], int array_count) {
-    for (int idx_check = 0; idx_check < array_count - 1; ++idx_check) {
-        if (data_array_ptr[idx_check] > data_array_ptr[idx_check + 1]) {
-            return 0; // O array NÃO está ordenado
+// Ordena um arquivo binário de inteiros de 32 bits (ordem nativa) no próprio arquivo, sem carregá-lo
+// inteiro na memória. O arquivo é mapeado com mmap e dividido em runs de 'run_elements' elementos:
+//   1. cada run é ordenado com o Odd-Even ladrilhado (mesmo kernel da versão em memória);
+//   2. os runs são intercalados por fases odd-even em nível de bloco: na fase par os pares de runs
+//      (0,1), (2,3), ... fazem merge-split, na fase ímpar (1,2), (3,4), ... Cada fase percorre o
+//      arquivo sequencialmente, com apenas dois runs (mais um buffer do mesmo tamanho) em uso.
+// Termina quando uma fase par e a ímpar seguinte não alteram nada (todas as fronteiras em ordem),
+// o que também encerra cedo entradas já quase ordenadas. Tamanhos e índices são de 64 bits, e as
+// dicas de madvise (advance_mapped_window) deixam o kernel ler adiante e descartar páginas já
+// processadas, permitindo arquivos maiores que a memória física.
+int sort_binary_file_mapped(const char *file_path, int run_elements, int tile_width, int phase_depth) {
+    int file_descriptor = open(file_path, O_RDWR);
+    if (file_descriptor < 0) {
+        fprintf(stderr, "Erro: não foi possível abrir '%s'.\n", file_path);
+        return EXIT_FAILURE;
+    }
+    struct stat file_info;
+    if (fstat(file_descriptor, &file_info) != 0 || file_info.st_size <= 0 ||
+        file_info.st_size % (off_t)sizeof(int) != 0) {
+        fprintf(stderr, "Erro: '%s' deve conter um número positivo de inteiros de %d bytes.\n",
+                file_path, (int)sizeof(int));
+        close(file_descriptor);
+        return EXIT_FAILURE;
+    }
+    int64_t total_elements = (int64_t)(file_info.st_size / (off_t)sizeof(int));
+    size_t mapped_bytes = (size_t)file_info.st_size;
+    int *mapped_keys = (int *)mmap(NULL, mapped_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+    close(file_descriptor); // O mapeamento continua válido após o close
+    if (mapped_keys == MAP_FAILED) {
+        fprintf(stderr, "Erro: falha ao mapear '%s' na memória.\n", file_path);
+        return EXIT_FAILURE;
+    }
+    madvise(mapped_keys, mapped_bytes, MADV_SEQUENTIAL);
+
+    if ((int64_t)run_elements > total_elements) {
+        run_elements = (int)total_elements;
+    }
+    int64_t run_count = (total_elements + run_elements - 1) / run_elements;
+    size_t run_bytes = (size_t)run_elements * sizeof(int);
+    int *merge_scratch = (int *)malloc(2 * run_bytes);
+    if (merge_scratch == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o buffer de intercalação.\n");
+        munmap(mapped_keys, mapped_bytes);
+        return EXIT_FAILURE;
+    }
+
+    fprintf(stderr, "Array inicial (segmento): ");
+    display_array_segment(mapped_keys, total_elements > 20 ? 21 : (int)total_elements, stderr);
+
+    // Assinatura de multiconjunto da entrada, para conferir depois que a saída é uma permutação dela
+    uint64_t input_checksum[MULTISET_CHECKSUM_WORDS], output_checksum[MULTISET_CHECKSUM_WORDS];
+    multiset_checksum_clear(input_checksum);
+    multiset_checksum_int(mapped_keys, total_elements, input_checksum);
+
+    struct timeval start_time_val, end_time_val;
+    trace_perf_begin(0);
+    gettimeofday(&start_time_val, NULL);
+
+    // Etapa 1: ordena cada run isoladamente (cabe em cache/RAM)
+    size_t released_bytes = 0, prefetched_bytes = 0;
+    for (int64_t run = 0; run < run_count; ++run) {
+        int64_t first = run * run_elements;
+        int current_size = (int)((total_elements - first < run_elements) ? total_elements - first : run_elements);
+        advance_mapped_window((char *)mapped_keys, mapped_bytes, &released_bytes, &prefetched_bytes,
+                              (size_t)first * sizeof(int));
+        perform_odd_even_sort_serial_tiled(mapped_keys + first, current_size, tile_width, phase_depth);
+    }
+    advance_mapped_window((char *)mapped_keys, mapped_bytes, &released_bytes, &prefetched_bytes, mapped_bytes);
+
+    // Etapa 2: fases odd-even entre runs vizinhos, em passadas sequenciais pelo arquivo
+    int64_t merge_phases = 0;
+    int quiet_phases = 0; // Fases consecutivas sem nenhuma troca
+    while (run_count > 1 && quiet_phases < 2) {
+        double merge_start = trace_enabled() ? trace_now_us() : 0.0;
+        int64_t phase_changes = 0;
+        released_bytes = prefetched_bytes = 0;
+        for (int64_t left_run = merge_phases % 2; left_run + 1 < run_count; left_run += 2) {
+            int64_t first = left_run * run_elements;
+            int64_t right_size = (total_elements - first - run_elements < run_elements)
+                                 ? total_elements - first - run_elements : run_elements;
+            advance_mapped_window((char *)mapped_keys, mapped_bytes, &released_bytes, &prefetched_bytes,
+                                  (size_t)first * sizeof(int));
+            phase_changes += merge_split_adjacent_runs(mapped_keys + first, run_elements, right_size, merge_scratch);
         }
+        advance_mapped_window((char *)mapped_keys, mapped_bytes, &released_bytes, &prefetched_bytes, mapped_bytes);
+        if (trace_enabled()) {
+            trace_record(0, TRACE_MERGE, (int)merge_phases, merge_start, trace_now_us(), 0.0, 0, phase_changes, 0);
+        }
+        quiet_phases = (phase_changes == 0) ? quiet_phases + 1 : 0;
+        merge_phases++;
+    }
+    msync(mapped_keys, mapped_bytes, MS_SYNC);
+
+    gettimeofday(&end_time_val, NULL);
+    trace_perf_end(0);
+    double elapsed_seconds = (double)(end_time_val.tv_sec - start_time_val.tv_sec) +
+                             (double)(end_time_val.tv_usec - start_time_val.tv_usec) / 1000000.0;
+
+    // Verificação em uma passada sequencial (índices de 64 bits): ordem e permutação da entrada
+    gettimeofday(&start_time_val, NULL);
+    int in_order = verify_sorted_int(mapped_keys, total_elements);
+    multiset_checksum_clear(output_checksum);
+    multiset_checksum_int(mapped_keys, total_elements, output_checksum);
+    int is_permutation = multiset_checksums_equal(input_checksum, output_checksum);
+    int is_sorted = in_order && is_permutation;
+    gettimeofday(&end_time_val, NULL);
+    double verify_seconds = (double)(end_time_val.tv_sec - start_time_val.tv_sec) +
+                            (double)(end_time_val.tv_usec - start_time_val.tv_usec) / 1000000.0;
+
+    fprintf(stdout, "Tempo de execução para ordenação serial (arquivo): %.6f segundos\n", elapsed_seconds);
+    fprintf(stdout, "Arquivo: %s, %lld elementos em %lld runs de até %d elementos, %lld fases de intercalação\n",
+            file_path, (long long)total_elements, (long long)run_count, run_elements, (long long)merge_phases);
+    fprintf(stdout, "Kernel de compare-exchange: %s\n", compare_exchange_kernel_name(select_compare_exchange_kernel()));
+    fprintf(stderr, "Array final (segmento): ");
+    display_array_segment(mapped_keys, total_elements > 20 ? 21 : (int)total_elements, stderr);
+    report_verification(stdout, in_order, is_permutation, verify_seconds);
+    fprintf(stdout, "Status de ordenação: %s\n", is_sorted ? "Ordenado" : "Não Ordenado");
+
+    trace_finish("odd_even_serial", "thread");
+    free(merge_scratch);
+    munmap(mapped_keys, mapped_bytes);
+    return is_sorted ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Versão tipada (ODD_EVEN_KEY / ODD_EVEN_PAYLOAD): o mesmo Odd-Even simples sobre chaves de outro
+// tipo ou registros, com o núcleo de odd_even_keys.h especializado para o elemento 'element_type'.
+// A assinatura de multiconjunto dos registros inclui o payload: confere também que cada payload
+// acompanhou a sua chave.
+#define DEFINE_TYPED_SERIAL_RUN(suffix, element_type)                                                  \
+int run_typed_serial_##suffix(long array_size, const input_config *input_settings, const char *type_text) { \
+    element_type *typed_array = (element_type *)malloc(array_size * sizeof(element_type));            \
+    if (typed_array == NULL) {                                                                         \
+        fprintf(stderr, "Erro ao alocar memória para o array.\n");                                    \
+        return EXIT_FAILURE;                                                                           \
+    }                                                                                                  \
+    fill_##suffix(typed_array, array_size, input_settings);                                            \
+    report_input_config(input_settings, stderr);                                                       \
+    fprintf(stderr, "Array inicial (segmento): ");                                                    \
+    display_segment_##suffix(typed_array, array_size, stderr);                                         \
+    uint64_t input_checksum[MULTISET_CHECKSUM_WORDS], output_checksum[MULTISET_CHECKSUM_WORDS];        \
+    multiset_checksum_clear(input_checksum);                                                           \
+    multiset_checksum_##suffix(typed_array, array_size, input_checksum);                               \
+                                                                                                       \
+    struct timeval start_time_val, end_time_val;                                                       \
+    trace_perf_begin(0);                                                                               \
+    gettimeofday(&start_time_val, NULL);                                                               \
+    odd_even_sort_##suffix(typed_array, array_size);                                                   \
+    gettimeofday(&end_time_val, NULL);                                                                 \
+    trace_perf_end(0);                                                                                 \
+    double elapsed_seconds = (double)(end_time_val.tv_sec - start_time_val.tv_sec) +                   \
+                             (double)(end_time_val.tv_usec - start_time_val.tv_usec) / 1000000.0;      \
+                                                                                                       \
+    fprintf(stdout, "Tempo de execução para ordenação serial (%s): %.6f segundos\n", type_text, elapsed_seconds); \
+    fprintf(stderr, "Array final (segmento): ");                                                      \
+    display_segment_##suffix(typed_array, array_size, stderr);                                         \
+    gettimeofday(&start_time_val, NULL);                                                               \
+    int in_order = verify_sorted_##suffix(typed_array, array_size);                                    \
+    multiset_checksum_clear(output_checksum);                                                          \
+    multiset_checksum_##suffix(typed_array, array_size, output_checksum);                              \
+    int is_permutation = multiset_checksums_equal(input_checksum, output_checksum);                    \
+    gettimeofday(&end_time_val, NULL);                                                                 \
+    report_verification(stdout, in_order, is_permutation,                                              \
+                        (double)(end_time_val.tv_sec - start_time_val.tv_sec) +                        \
+                        (double)(end_time_val.tv_usec - start_time_val.tv_usec) / 1000000.0);          \
+    fprintf(stdout, "Status de ordenação: %s\n", (in_order && is_permutation) ? "Ordenado" : "Não Ordenado"); \
+    trace_finish("odd_even_serial", "thread");                                                         \
+    free(typed_array);                                                                                 \
+    return (in_order && is_permutation) ? EXIT_SUCCESS : EXIT_FAILURE;                                 \
+}
+
+#define DEFINE_TYPED_SERIAL_RUNS(name, type)                                                           \
+    DEFINE_TYPED_SERIAL_RUN(name, type)                                                                \
+    DEFINE_TYPED_SERIAL_RUN(record_##name, record_##name)
+
+ODD_EVEN_KEY_TYPES(DEFINE_TYPED_SERIAL_RUNS)
+
+// Despacha para a versão especializada do tipo configurado
+int run_typed_serial(const key_config *key_settings, long array_size, const input_config *input_settings) {
+    char type_text[32];
+    describe_key_config(key_settings, type_text, sizeof(type_text));
+    switch (key_settings->type) {
+#define TYPED_SERIAL_CASE(name, type)                                                                  \
+    case KEY_TYPE_##name:                                                                              \
+        return key_settings->with_payload                                                              \
+                   ? run_typed_serial_record_##name(array_size, input_settings, type_text)            \
+                   : run_typed_serial_##name(array_size, input_settings, type_text);
+        ODD_EVEN_KEY_TYPES(TYPED_SERIAL_CASE)
+#undef TYPED_SERIAL_CASE
+    default:
+        return EXIT_FAILURE;
     }
-    return 1; // O array está corretamente ordenado
 }
 
 int main(int argc, char *argv[]) {
-    // Validação da linha de comando: requer exatamente um argumento (tamanho do array)
-    if (argc != 2) {
-        fprintf(stderr, "Uso correto: %s <tamanho_do_array>\n", argv[0]);
+    trace_init();
+
+    // Modo arquivo (fora da memória): ordena no próprio arquivo binário de inteiros de 32 bits
+    if (argc >= 3 && strcmp(argv[1], "-f") == 0) {
+        if (argc > 6) {
+            fprintf(stderr, "Uso correto: %s -f <arquivo.bin> [elementos_por_run] [largura_ladrilho] [profundidade]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+        int run_elements = (argc >= 4) ? atoi(argv[3]) : 65536;
+        int file_tile_width = (argc >= 5) ? atoi(argv[4]) : 16384;
+        int file_phase_depth = (argc >= 6) ? atoi(argv[5]) : 1024;
+        if (run_elements <= 0 || file_tile_width <= 0 || file_phase_depth <= 0) {
+            fprintf(stderr, "Erro: elementos por run, largura do ladrilho e profundidade devem ser positivos.\n");
+            return EXIT_FAILURE;
+        }
+        return sort_binary_file_mapped(argv[2], run_elements, file_tile_width, file_phase_depth);
+    }
+
+    // Validação da linha de comando: tamanho do array e, opcionalmente, o modo ladrilhado
+    // com largura do ladrilho (em pares) e profundidade (fases por ladrilho)
+    if (argc < 2 || argc > 5) {
+        fprintf(stderr, "Uso correto: %s <tamanho_do_array> [modo: simples|ladrilhado] [largura_ladrilho] [profundidade]\n"
+                        "         ou: %s -f <arquivo.bin> [elementos_por_run] [largura_ladrilho] [profundidade]\n",
+                argv[0], argv[0]);
         return EXIT_FAILURE; // Retorna código de erro
     }
 
+    const char *sort_mode = (argc >= 3) ? argv[2] : "simples";
+    int tile_width = (argc >= 4) ? atoi(argv[3]) : 16384;
+    int phase_depth = (argc >= 5) ? atoi(argv[4]) : 1024;
+    if (strcmp(sort_mode, "simples") != 0 && strcmp(sort_mode, "ladrilhado") != 0) {
+        fprintf(stderr, "Erro: o modo deve ser 'simples' ou 'ladrilhado'.\n");
+        return EXIT_FAILURE;
+    }
+    if (tile_width <= 0 || phase_depth <= 0) {
+        fprintf(stderr, "Erro: largura do ladrilho e profundidade devem ser positivas.\n");
+        return EXIT_FAILURE;
+    }
+
     int array_size = atoi(argv[1]); // Converte o argumento para inteiro
     if (array_size <= 0) {
         fprintf(stderr, "Erro: O tamanho do array deve ser um número inteiro positivo.\n");
         return EXIT_FAILURE;
     }
 
+    // Distribuição e semente da entrada (ODD_EVEN_DIST / ODD_EVEN_SEED)
+    input_config input_settings;
+    if (!read_input_config(&input_settings)) {
+        return EXIT_FAILURE;
+    }
+
+    // Tipo da chave (ODD_EVEN_KEY / ODD_EVEN_PAYLOAD); os demais tipos usam o modo simples
+    key_config key_settings;
+    if (!read_key_config(&key_settings)) {
+        return EXIT_FAILURE;
+    }
+    if (!key_config_is_default(&key_settings)) {
+        if (strcmp(sort_mode, "simples") != 0) {
+            fprintf(stderr, "Erro: o modo '%s' está disponível apenas para chaves int sem payload.\n", sort_mode);
+            return EXIT_FAILURE;
+        }
+        return run_typed_serial(&key_settings, array_size, &input_settings);
+    }
+
     // Aloca memória para o array de inteiros
     int *main_array = (int *)malloc(array_size * sizeof(int));
     if (main_array == NULL) {
@@ -90,36 +387,62 @@ int main(int argc, char *argv[]) {
     struct timeval start_time_val, end_time_val;
     double elapsed_seconds;
     
-    // Preenche o array com valores aleatórios (entre 0 e 999)
-    fill_with_random_numbers(main_array, array_size, 1000);
+    // Preenche o array conforme a distribuição configurada (padrão: valores entre 0 e 999)
+    fill_input_array(main_array, array_size, &input_settings);
+    report_input_config(&input_settings, stderr);
     
     fprintf(stderr, "Array inicial (segmento): ");
     display_array_segment(main_array, array_size, stderr);
 
+    // Assinatura de multiconjunto da entrada (fora da medição), para a verificação de permutação
+    uint64_t input_checksum[MULTISET_CHECKSUM_WORDS], output_checksum[MULTISET_CHECKSUM_WORDS];
+    multiset_checksum_clear(input_checksum);
+    multiset_checksum_int(main_array, array_size, input_checksum);
+
     // Inicia a contagem de tempo
+    trace_perf_begin(0);
     gettimeofday(&start_time_val, NULL);
     
     // Executa o algoritmo de ordenação serial
-    perform_odd_even_sort_serial(main_array, array_size);
+    if (strcmp(sort_mode, "ladrilhado") == 0) {
+        perform_odd_even_sort_serial_tiled(main_array, array_size, tile_width, phase_depth);
+    } else {
+        perform_odd_even_sort_serial(main_array, array_size);
+    }
     
     // Finaliza a contagem de tempo
     gettimeofday(&end_time_val, NULL);
+    trace_perf_end(0);
 
     // Calcula o tempo total decorrido em segundos
     elapsed_seconds = (double)(end_time_val.tv_sec - start_time_val.tv_sec) +
                       (double)(end_time_val.tv_usec - start_time_val.tv_usec) / 1000000.0;
 
     fprintf(stdout, "Tempo de execução para ordenação serial: %.6f segundos\n", elapsed_seconds);
+    if (strcmp(sort_mode, "ladrilhado") == 0) {
+        fprintf(stdout, "Modo ladrilhado: largura %d pares, profundidade %d fases\n", tile_width, phase_depth);
+    }
+    fprintf(stdout, "Kernel de compare-exchange: %s\n", compare_exchange_kernel_name(select_compare_exchange_kernel()));
 
     fprintf(stderr, "Array final (segmento): ");
     display_array_segment(main_array, array_size, stderr);
 
-    // Verifica e imprime se o array está ordenado
-    fprintf(stdout, "Status de ordenação: %s\n", check_if_sorted(main_array, array_size) ? "Ordenado" : "Não Ordenado");
+    // Verifica a ordem e se a saída é uma permutação da entrada
+    gettimeofday(&start_time_val, NULL);
+    int in_order = verify_sorted_int(main_array, array_size);
+    multiset_checksum_clear(output_checksum);
+    multiset_checksum_int(main_array, array_size, output_checksum);
+    int is_permutation = multiset_checksums_equal(input_checksum, output_checksum);
+    gettimeofday(&end_time_val, NULL);
+    report_verification(stdout, in_order, is_permutation,
+                        (double)(end_time_val.tv_sec - start_time_val.tv_sec) +
+                        (double)(end_time_val.tv_usec - start_time_val.tv_usec) / 1000000.0);
+    fprintf(stdout, "Status de ordenação: %s\n", (in_order && is_permutation) ? "Ordenado" : "Não Ordenado");
+    trace_finish("odd_even_serial", "thread");
     
     // Libera a memória alocada
     free(main_array);
     main_array = NULL; // Boa prática para evitar 'dangling pointer'
 
-    return EXIT_SUCCESS; // Retorna sucesso
+    return (in_order && is_permutation) ? EXIT_SUCCESS : EXIT_FAILURE; // Sucesso só se a saída passou na verificação
 }
\ No newline at end of file
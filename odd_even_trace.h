@@ -0,0 +1,416 @@
+#ifndef ODD_EVEN_TRACE_H
+#define ODD_EVEN_TRACE_H
+
+// Instrumentação opcional compartilhada pelas versões serial, OpenMP e MPI.
+//
+// Ativada por variáveis de ambiente (desativada, cada ponto de instrumentação custa apenas o teste
+// de um flag global e o kernel de compare-exchange não é embrulhado):
+//   ODD_EVEN_TRACE=<arquivo.json>     grava os eventos no formato Chrome trace (chrome://tracing,
+//                                     ui.perfetto.dev) e imprime uma tabela-resumo em stderr
+//   ODD_EVEN_PERF=1                   lê ciclos, falhas de LLC e falhas de predição de desvio de cada
+//                                     thread/processo via perf_event_open (também sem ODD_EVEN_TRACE)
+//   ODD_EVEN_TRACE_MAX_EVENTS=<n>     limite de eventos guardados por linha (padrão 1000000); o resumo
+//                                     continua completo mesmo quando eventos são descartados
+//
+// Cada evento pertence a uma "linha" (thread OpenMP, ou a thread principal de cada processo MPI) e
+// registra início, duração, tempo de espera por comunicação contido nele, comparações, trocas e
+// bytes enviados. As comparações e trocas das fases vêm de um kernel de compare-exchange embrulhado
+// (trace_instrument_kernel), que conta os pares fora de ordem antes de aplicar o kernel real.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#define TRACE_MAX_TRACKS 256
+#define TRACE_HARDWARE_COUNTERS 3
+
+typedef enum {
+    TRACE_PHASE,      // fase (ou bloco de fases) de compare-exchange
+    TRACE_BARRIER,    // espera em barreira OpenMP
+    TRACE_EXCHANGE,   // troca ponto a ponto (MPI_Sendrecv, MPI_Wait* das trocas)
+    TRACE_REDUCE,     // redução/teste de convergência (MPI_Allreduce, MPI_Iallreduce)
+    TRACE_MERGE,      // merge-split de blocos
+    TRACE_LOCAL_SORT  // ordenação local inicial de um bloco
+} trace_kind;
+
+static const char *const trace_kind_names[] = {
+    "fase", "barreira", "troca", "redução", "merge_split", "ordenação_local"
+};
+
+static const char *const trace_hardware_names[TRACE_HARDWARE_COUNTERS] = {
+    "ciclos", "falhas_llc", "falhas_desvio"
+};
+
+typedef struct {
+    int kind, process, track, phase; // phase < 0: evento sem fase associada
+    double start_us, duration_us, wait_us;
+    long long comparisons, swaps, bytes;
+} trace_event;
+
+typedef struct {
+    long long comparisons, swaps, bytes_sent, dropped_events;
+    double compute_us, barrier_us, comm_us;
+    long long hardware[TRACE_HARDWARE_COUNTERS];
+    int hardware_valid;
+} trace_summary;
+
+typedef struct {
+    trace_event *events;
+    size_t count, capacity;
+    trace_summary summary;
+    int perf_fds[TRACE_HARDWARE_COUNTERS];
+    int used;
+} trace_track;
+
+typedef struct {
+    int enabled, perf_enabled, process;
+    const char *output_path;
+    size_t max_events_per_track;
+    double origin_us;
+    trace_track tracks[TRACE_MAX_TRACKS];
+} trace_state;
+
+static trace_state odd_even_trace;
+
+// Mesma assinatura de compare_exchange_kernel_fn (odd_even_kernel.h)
+typedef void (*trace_pair_kernel_fn)(int *pairs, int pair_count);
+
+// Contadores do kernel embrulhado, por thread
+static __thread long long trace_thread_comparisons, trace_thread_swaps;
+static trace_pair_kernel_fn trace_wrapped_kernel;
+
+static inline double trace_now_us(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e6 + (double)now.tv_nsec / 1e3 - odd_even_trace.origin_us;
+}
+
+// Lê as variáveis de ambiente; chamado uma vez no início de main
+static inline void trace_init(void) {
+    const char *output_path = getenv("ODD_EVEN_TRACE");
+    const char *perf_flag = getenv("ODD_EVEN_PERF");
+    const char *max_events = getenv("ODD_EVEN_TRACE_MAX_EVENTS");
+    odd_even_trace.output_path = (output_path != NULL && output_path[0] != '\0') ? output_path : NULL;
+    odd_even_trace.perf_enabled = (perf_flag != NULL && strcmp(perf_flag, "0") != 0);
+    odd_even_trace.enabled = (odd_even_trace.output_path != NULL || odd_even_trace.perf_enabled);
+    odd_even_trace.max_events_per_track = (max_events != NULL) ? strtoull(max_events, NULL, 10) : 1000000;
+    odd_even_trace.origin_us = 0.0;
+    odd_even_trace.origin_us = trace_now_us();
+}
+
+static inline int trace_enabled(void) {
+    return __builtin_expect(odd_even_trace.enabled, 0);
+}
+
+// Identificador do processo nos eventos (rank MPI); zera a origem dos tempos, de modo que processos
+// sincronizados por uma barreira antes desta chamada compartilhem o mesmo eixo de tempo
+static inline void trace_set_process(int process) {
+    odd_even_trace.process = process;
+    odd_even_trace.origin_us = 0.0;
+    odd_even_trace.origin_us = trace_now_us();
+}
+
+// Kernel de compare-exchange que conta comparações e trocas antes de chamar o kernel real
+static inline void trace_counting_kernel(int *pairs, int pair_count) {
+    long long swaps = 0;
+    for (int k = 0; k < pair_count; ++k) {
+        swaps += (pairs[2 * k] > pairs[2 * k + 1]);
+    }
+    trace_thread_comparisons += pair_count;
+    trace_thread_swaps += swaps;
+    trace_wrapped_kernel(pairs, pair_count);
+}
+
+// Com a instrumentação ativa, devolve o kernel que conta; caso contrário, o próprio kernel
+static inline trace_pair_kernel_fn trace_instrument_kernel(trace_pair_kernel_fn kernel) {
+    if (!trace_enabled()) {
+        return kernel;
+    }
+    trace_wrapped_kernel = kernel;
+    return trace_counting_kernel;
+}
+
+// Registra um evento [start_us, end_us) na linha 'track'. 'wait_us' é a parte do evento gasta
+// esperando comunicação (trocas e reduções são inteiramente espera).
+static inline void trace_record(int track, trace_kind kind, int phase, double start_us, double end_us,
+                                double wait_us, long long comparisons, long long swaps, long long bytes) {
+    if (track < 0 || track >= TRACE_MAX_TRACKS) {
+        return;
+    }
+    trace_track *line = &odd_even_trace.tracks[track];
+    double duration_us = end_us - start_us;
+    line->used = 1;
+    line->summary.comparisons += comparisons;
+    line->summary.swaps += swaps;
+    line->summary.bytes_sent += bytes;
+    if (kind == TRACE_BARRIER) {
+        line->summary.barrier_us += duration_us;
+    } else if (kind == TRACE_EXCHANGE || kind == TRACE_REDUCE) {
+        line->summary.comm_us += duration_us;
+    } else {
+        line->summary.compute_us += duration_us - wait_us;
+        line->summary.comm_us += wait_us;
+    }
+
+    if (odd_even_trace.output_path == NULL) {
+        return;
+    }
+    if (line->count >= odd_even_trace.max_events_per_track) {
+        line->summary.dropped_events++;
+        return;
+    }
+    if (line->count == line->capacity) {
+        size_t new_capacity = (line->capacity == 0) ? 1024 : 2 * line->capacity;
+        trace_event *grown = (trace_event *)realloc(line->events, new_capacity * sizeof(trace_event));
+        if (grown == NULL) {
+            line->summary.dropped_events++;
+            return;
+        }
+        line->events = grown;
+        line->capacity = new_capacity;
+    }
+    trace_event *event = &line->events[line->count++];
+    event->kind = kind;
+    event->process = odd_even_trace.process;
+    event->track = track;
+    event->phase = phase;
+    event->start_us = start_us;
+    event->duration_us = duration_us;
+    event->wait_us = wait_us;
+    event->comparisons = comparisons;
+    event->swaps = swaps;
+    event->bytes = bytes;
+}
+
+// Registra uma fase aplicada pelo kernel embrulhado, consumindo os contadores da thread atual
+static inline void trace_record_kernel_phase(int track, int phase, double start_us, double end_us) {
+    trace_record(track, TRACE_PHASE, phase, start_us, end_us, 0.0, trace_thread_comparisons, trace_thread_swaps, 0);
+    trace_thread_comparisons = 0;
+    trace_thread_swaps = 0;
+}
+
+#ifdef __linux__
+static inline int trace_perf_open_counter(uint32_t type, uint64_t config) {
+    struct perf_event_attr attributes;
+    memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = type;
+    attributes.config = config;
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    // pid 0, cpu -1: apenas a thread que chama, em qualquer CPU
+    return (int)syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0);
+}
+#endif
+
+// Abre e liga os contadores de hardware da thread atual (linha 'track')
+static inline void trace_perf_begin(int track) {
+    if (!odd_even_trace.perf_enabled || track < 0 || track >= TRACE_MAX_TRACKS) {
+        return;
+    }
+    trace_track *line = &odd_even_trace.tracks[track];
+    line->used = 1;
+#ifdef __linux__
+    line->perf_fds[0] = trace_perf_open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    line->perf_fds[1] = trace_perf_open_counter(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL |
+                                                (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    line->perf_fds[2] = trace_perf_open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    for (int counter = 0; counter < TRACE_HARDWARE_COUNTERS; ++counter) {
+        if (line->perf_fds[counter] >= 0) {
+            ioctl(line->perf_fds[counter], PERF_EVENT_IOC_RESET, 0);
+            ioctl(line->perf_fds[counter], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#else
+    for (int counter = 0; counter < TRACE_HARDWARE_COUNTERS; ++counter) line->perf_fds[counter] = -1;
+#endif
+}
+
+// Desliga, lê e fecha os contadores da thread atual; contadores indisponíveis ficam em -1
+static inline void trace_perf_end(int track) {
+    if (!odd_even_trace.perf_enabled || track < 0 || track >= TRACE_MAX_TRACKS) {
+        return;
+    }
+    trace_track *line = &odd_even_trace.tracks[track];
+    line->summary.hardware_valid = 0;
+    for (int counter = 0; counter < TRACE_HARDWARE_COUNTERS; ++counter) {
+        line->summary.hardware[counter] = -1;
+#ifdef __linux__
+        uint64_t value;
+        if (line->perf_fds[counter] >= 0) {
+            ioctl(line->perf_fds[counter], PERF_EVENT_IOC_DISABLE, 0);
+            if (read(line->perf_fds[counter], &value, sizeof(value)) == (ssize_t)sizeof(value)) {
+                line->summary.hardware[counter] = (long long)value;
+                line->summary.hardware_valid = 1;
+            }
+            close(line->perf_fds[counter]);
+        }
+#endif
+    }
+}
+
+// Junta os eventos de todas as linhas em um único vetor (o chamador libera com free)
+static inline trace_event *trace_collect_events(size_t *event_count) {
+    size_t total = 0;
+    for (int track = 0; track < TRACE_MAX_TRACKS; ++track) total += odd_even_trace.tracks[track].count;
+    trace_event *events = (trace_event *)malloc((total > 0 ? total : 1) * sizeof(trace_event));
+    if (events == NULL) {
+        *event_count = 0;
+        return NULL;
+    }
+    size_t offset = 0;
+    for (int track = 0; track < TRACE_MAX_TRACKS; ++track) {
+        trace_track *line = &odd_even_trace.tracks[track];
+        if (line->count > 0) {
+            memcpy(events + offset, line->events, line->count * sizeof(trace_event));
+            offset += line->count;
+        }
+    }
+    *event_count = total;
+    return events;
+}
+
+// Linhas usadas, na ordem; devolve quantas foram copiadas para 'summaries'
+static inline int trace_collect_summaries(trace_summary summaries[], int track_ids[]) {
+    int used_tracks = 0;
+    for (int track = 0; track < TRACE_MAX_TRACKS; ++track) {
+        if (odd_even_trace.tracks[track].used) {
+            summaries[used_tracks] = odd_even_trace.tracks[track].summary;
+            track_ids[used_tracks] = track;
+            used_tracks++;
+        }
+    }
+    return used_tracks;
+}
+
+// Grava o arquivo Chrome trace; 'process_label' nomeia cada processo ("rank" no MPI)
+static inline int trace_write_chrome_json(const char *output_path, const trace_event events[], size_t event_count,
+                                          const char *program_name, const char *process_label, int process_count,
+                                          const trace_summary summaries[], const int summary_process[],
+                                          const int summary_track[], int summary_count) {
+    FILE *trace_file = fopen(output_path, "w");
+    if (trace_file == NULL) {
+        fprintf(stderr, "Erro: não foi possível gravar o trace em '%s'.\n", output_path);
+        return 0;
+    }
+    fprintf(trace_file, "{\"displayTimeUnit\": \"ms\", \"otherData\": {\"programa\": \"%s\"}, \"traceEvents\": [\n",
+            program_name);
+    const char *separator = "";
+    for (int process = 0; process < process_count; ++process) {
+        fprintf(trace_file, "%s{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": %d, \"args\": {\"name\": \"%s %d\"}}",
+                separator, process, process_label, process);
+        separator = ",\n";
+    }
+    for (size_t idx = 0; idx < event_count; ++idx) {
+        const trace_event *event = &events[idx];
+        fprintf(trace_file, "%s{\"name\": \"%s\", \"cat\": \"odd_even\", \"ph\": \"X\", \"pid\": %d, \"tid\": %d, "
+                            "\"ts\": %.3f, \"dur\": %.3f, \"args\": {",
+                separator, trace_kind_names[event->kind], event->process, event->track,
+                event->start_us, event->duration_us);
+        if (event->phase >= 0) fprintf(trace_file, "\"fase\": %d, ", event->phase);
+        fprintf(trace_file, "\"comparacoes\": %lld, \"trocas\": %lld, \"bytes\": %lld, \"espera_us\": %.3f}}",
+                event->comparisons, event->swaps, event->bytes, event->wait_us);
+    }
+    // Contadores de hardware como um evento instantâneo ao fim de cada linha
+    for (int row = 0; row < summary_count; ++row) {
+        if (!summaries[row].hardware_valid) continue;
+        fprintf(trace_file, "%s{\"name\": \"contadores_de_hardware\", \"ph\": \"i\", \"s\": \"t\", \"pid\": %d, "
+                            "\"tid\": %d, \"ts\": 0, \"args\": {",
+                separator, summary_process[row], summary_track[row]);
+        for (int counter = 0; counter < TRACE_HARDWARE_COUNTERS; ++counter) {
+            fprintf(trace_file, "%s\"%s\": %lld", counter ? ", " : "", trace_hardware_names[counter],
+                    summaries[row].hardware[counter]);
+        }
+        fprintf(trace_file, "}}");
+    }
+    fprintf(trace_file, "\n]}\n");
+    fclose(trace_file);
+    return 1;
+}
+
+// Tabela-resumo, uma linha por thread/processo
+static inline void trace_print_summary(FILE *output_stream, const char *row_label, const trace_summary summaries[],
+                                       const int row_ids[], int row_count) {
+    fprintf(output_stream, "\n--- Instrumentação (por %s) ---\n", row_label);
+    // "comparações" tem dois caracteres de 2 bytes em UTF-8, daí a largura 16
+    fprintf(output_stream, "%8s %16s %14s %12s %12s %12s %14s %12s %12s %12s\n", row_label, "comparações",
+            "trocas", "comput.(ms)", "barreira(ms)", "comunic.(ms)", "bytes_env.", "ciclos", "falhas_llc",
+            "falhas_desv.");
+    trace_summary total;
+    memset(&total, 0, sizeof(total));
+    for (int row = 0; row < row_count; ++row) {
+        const trace_summary *line = &summaries[row];
+        fprintf(output_stream, "%8d %14lld %14lld %12.3f %12.3f %12.3f %14lld", row_ids[row], line->comparisons,
+                line->swaps, line->compute_us / 1e3, line->barrier_us / 1e3, line->comm_us / 1e3, line->bytes_sent);
+        for (int counter = 0; counter < TRACE_HARDWARE_COUNTERS; ++counter) {
+            if (line->hardware_valid && line->hardware[counter] >= 0) {
+                fprintf(output_stream, " %12lld", line->hardware[counter]);
+                total.hardware[counter] += line->hardware[counter];
+            } else {
+                fprintf(output_stream, " %12s", "-");
+            }
+        }
+        fprintf(output_stream, "\n");
+        total.comparisons += line->comparisons;
+        total.swaps += line->swaps;
+        total.compute_us += line->compute_us;
+        total.barrier_us += line->barrier_us;
+        total.comm_us += line->comm_us;
+        total.bytes_sent += line->bytes_sent;
+        total.dropped_events += line->dropped_events;
+    }
+    fprintf(output_stream, "%8s %14lld %14lld %12.3f %12.3f %12.3f %14lld\n", "total", total.comparisons,
+            total.swaps, total.compute_us / 1e3, total.barrier_us / 1e3, total.comm_us / 1e3, total.bytes_sent);
+    int any_hardware = 0;
+    for (int row = 0; row < row_count; ++row) any_hardware |= summaries[row].hardware_valid;
+    if (odd_even_trace.perf_enabled && !any_hardware) {
+        fprintf(output_stream, "Aviso: contadores de hardware indisponíveis (perf_event_open falhou; "
+                               "verifique /proc/sys/kernel/perf_event_paranoid).\n");
+    }
+    if (total.dropped_events > 0) {
+        fprintf(output_stream, "Aviso: %lld eventos descartados (ODD_EVEN_TRACE_MAX_EVENTS); o resumo está completo.\n",
+                total.dropped_events);
+    }
+}
+
+static inline void trace_release(void) {
+    for (int track = 0; track < TRACE_MAX_TRACKS; ++track) {
+        free(odd_even_trace.tracks[track].events);
+        odd_even_trace.tracks[track].events = NULL;
+        odd_even_trace.tracks[track].count = odd_even_trace.tracks[track].capacity = 0;
+    }
+}
+
+// Fim da execução em um único processo (serial e OpenMP): grava o trace, imprime o resumo e libera
+static inline void trace_finish(const char *program_name, const char *row_label) {
+    if (!trace_enabled()) {
+        return;
+    }
+    trace_summary summaries[TRACE_MAX_TRACKS];
+    int track_ids[TRACE_MAX_TRACKS], process_ids[TRACE_MAX_TRACKS];
+    int row_count = trace_collect_summaries(summaries, track_ids);
+    for (int row = 0; row < row_count; ++row) process_ids[row] = 0;
+    if (odd_even_trace.output_path != NULL) {
+        size_t event_count;
+        trace_event *events = trace_collect_events(&event_count);
+        if (trace_write_chrome_json(odd_even_trace.output_path, events, event_count, program_name, "processo", 1,
+                                    summaries, process_ids, track_ids, row_count)) {
+            fprintf(stderr, "Trace gravado em %s (%zu eventos)\n", odd_even_trace.output_path, event_count);
+        }
+        free(events);
+    }
+    trace_print_summary(stderr, row_label, summaries, track_ids, row_count);
+    trace_release();
+}
+
+#endif // ODD_EVEN_TRACE_H
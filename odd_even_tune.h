@@ -0,0 +1,75 @@
+#ifndef ODD_EVEN_TUNE_H
+#define ODD_EVEN_TUNE_H
+
+// Perfil de desempenho por máquina, gerado por 'python3 autotune.py calibrar' e consultado pelo modo
+// 'auto' dos programas. O perfil é um arquivo de texto com a melhor configuração de cada motor em
+// cada tamanho calibrado, uma por linha:
+//
+//   # comentário
+//   <tamanho> <motor> <trabalhadores> <política> <largura> <profundidade> <mediana_s>
+//
+// Largura e profundidade valem 0 quando a configuração usa os padrões do programa. A consulta só lê
+// o arquivo: a calibração não tem custo nas execuções seguintes.
+//
+// Variável de ambiente:
+//   ODD_EVEN_PROFILE=<arquivo>   perfil a usar (padrão: odd_even_perfil_<host>.txt no diretório atual)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+typedef struct {
+    long size;          // Tamanho calibrado
+    char engine[16];    // serial, openmp ou mpi
+    int workers;        // Threads ou processos
+    char policy[16];    // Política (OpenMP), modo (serial) ou modo de troca (MPI)
+    int width;          // Largura do ladrilho/pedaço (0 = padrão)
+    int depth;          // Profundidade do ladrilho ou fases entre verificações (0 = padrão)
+    double seconds;     // Mediana medida na calibração
+} tune_entry;
+
+// Caminho do perfil desta máquina
+static inline void tune_profile_path(char *path, size_t path_size) {
+    const char *configured = getenv("ODD_EVEN_PROFILE");
+    if (configured != NULL && configured[0] != '\0') {
+        snprintf(path, path_size, "%s", configured);
+        return;
+    }
+    char host[256] = "desconhecido";
+    gethostname(host, sizeof(host) - 1);
+    host[sizeof(host) - 1] = '\0';
+    snprintf(path, path_size, "odd_even_perfil_%s.txt", host);
+}
+
+// Distância entre tamanhos em escala logarítmica (razão entre o maior e o menor)
+static inline double tune_size_distance(long calibrated, long requested) {
+    return (calibrated > requested) ? (double)calibrated / (double)requested
+                                    : (double)requested / (double)calibrated;
+}
+
+// Procura no perfil a entrada do motor 'engine' cujo tamanho calibrado é o mais próximo de 'n'.
+// Retorna 1 e preenche 'chosen' se encontrou; 0 se o arquivo não existe ou não tem o motor.
+static inline int tune_lookup(const char *path, const char *engine, long n, tune_entry *chosen) {
+    FILE *profile = fopen(path, "r");
+    if (profile == NULL) return 0;
+    int found = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), profile) != NULL) {
+        tune_entry entry;
+        if (line[0] == '#' ||
+            sscanf(line, "%ld %15s %d %15s %d %d %lf", &entry.size, entry.engine, &entry.workers,
+                   entry.policy, &entry.width, &entry.depth, &entry.seconds) != 7) {
+            continue;
+        }
+        if (strcmp(entry.engine, engine) != 0 || entry.size <= 0 || entry.workers <= 0) continue;
+        if (!found || tune_size_distance(entry.size, n) < tune_size_distance(chosen->size, n)) {
+            *chosen = entry;
+            found = 1;
+        }
+    }
+    fclose(profile);
+    return found;
+}
+
+#endif // ODD_EVEN_TUNE_H
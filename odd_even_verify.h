@@ -0,0 +1,68 @@
+#ifndef ODD_EVEN_VERIFY_H
+#define ODD_EVEN_VERIFY_H
+
+// Verificação da saída em uma única passada paralela, compartilhada pelas versões serial, OpenMP e MPI.
+//
+// Ordem: cada par vizinho é conferido por um laço paralelo (redução OpenMP da quantidade de pares
+// fora de ordem); na versão MPI cada processo confere o próprio bloco e a fronteira com o vizinho da
+// direita sai de uma única troca, sem reunir o array em um processo.
+//
+// Permutação: a saída deve ser uma permutação da entrada. Cada elemento é reduzido a 64 bits
+// (os bits da chave e, nos registros, o payload), espalhado por duas misturas independentes (o
+// finalizador do SplitMix64 e o fmix64 do MurmurHash3, com multiplicadores e deslocamentos
+// diferentes), e as misturas são somadas módulo 2^64. Somas não dependem da ordem nem da
+// partição, então a assinatura de multiconjunto é combinada por reduction(+) no OpenMP e por
+// MPI_SUM no MPI; entrada e saída com a mesma assinatura são, com probabilidade esmagadora, o
+// mesmo multiconjunto de elementos.
+
+#include <stdio.h>
+#include <stdint.h>
+#include "odd_even_input.h"
+
+// Palavras da assinatura de multiconjunto (uma soma por mistura)
+#define MULTISET_CHECKSUM_WORDS 2
+// Abaixo desta quantidade de elementos a verificação roda sem abrir região paralela
+#define VERIFY_PARALLEL_MIN_ITEMS 65536
+
+// Laços de verificação: paralelos quando compilados com OpenMP, seriais caso contrário
+#ifdef _OPENMP
+#define VERIFY_PRAGMA(text) _Pragma(text)
+#else
+#define VERIFY_PRAGMA(text)
+#endif
+
+static inline void multiset_checksum_clear(uint64_t checksum[]) {
+    for (int word = 0; word < MULTISET_CHECKSUM_WORDS; ++word) checksum[word] = 0;
+}
+
+// Primeira palavra: finalizador do SplitMix64
+static inline uint64_t multiset_mix_first(uint64_t bits) {
+    return splitmix64_at(0x6A09E667F3BCC908ULL, bits);
+}
+
+// Segunda palavra: fmix64 do MurmurHash3, que não é o SplitMix64 deslocado. A constante tira o
+// ponto fixo do zero (fmix64(0) = 0), que deixaria zeros fora da soma.
+static inline uint64_t multiset_mix_second(uint64_t bits) {
+    uint64_t hash = bits ^ 0xBB67AE8584CAA73BULL;
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB93E53BA0C6BULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+static inline int multiset_checksums_equal(const uint64_t first[], const uint64_t second[]) {
+    for (int word = 0; word < MULTISET_CHECKSUM_WORDS; ++word) {
+        if (first[word] != second[word]) return 0;
+    }
+    return 1;
+}
+
+// Linha de relatório comum; a saída só conta como ordenada se passar nas duas verificações
+static inline void report_verification(FILE *stream, int sorted, int permutation, double seconds) {
+    fprintf(stream, "Verificação: ordem %s, permutação da entrada %s (%.6f segundos)\n",
+            sorted ? "ok" : "FALHOU", permutation ? "ok" : "FALHOU", seconds);
+}
+
+#endif // ODD_EVEN_VERIFY_H